@@ -0,0 +1,61 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_BATCH_SOLVER_H
+#define F2_CMAX_BATCH_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Solver of many small F2||Cmax instances without the overhead of Instance, Parser and Solver. The instances are packed
+ * contiguously and solved LANES at a time: the jobs of each set A and B are stored slot by slot with one lane per
+ * instance, sorted by a bitonic sorting network whose compare-exchanges are branchless over the lanes, and evaluated
+ * with the (max,+) recurrence over the lanes. Both steps use the GCC vector extension, so that each operation is done
+ * on all the instances of the lanes by SIMD instructions (compile with -march=native, as in release mode).
+ */
+class BatchSolver {
+public:
+    static constexpr size_t MAX_JOBS = 64; // largest instance solved by the sorting networks
+    static constexpr size_t LANES = 8; // number of instances solved together
+
+    /**
+     * Method that computes the optimal makespan of each instance of a batch. An instance with more than MAX_JOBS jobs is
+     * solved with a comparison sort.
+     * @param jobs The processing times of all jobs, job j of the batch is (jobs[2j], jobs[2j+1])
+     * @param offsets The index of the first job of each instance, instance i has the jobs offsets[i] to offsets[i+1]-1
+     * @param nbInstances The number of instances, offsets must have nbInstances+1 elements
+     * @param cmax The array of nbInstances makespans to fill
+     */
+    static void solve(const double *jobs, const uint32_t *offsets, size_t nbInstances, double *cmax);
+
+    /**
+     * Method that computes the optimal makespan of each instance of a batch.
+     * @see BatchSolver::solve(const double*, const uint32_t*, size_t, double*)
+     * @return The makespan of each instance
+     */
+    static std::vector<double> solve(const double *jobs, const uint32_t *offsets, size_t nbInstances);
+};
+
+#endif //F2_CMAX_BATCH_SOLVER_H
@@ -0,0 +1,139 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_COST_MODEL_H
+#define F2_CMAX_COST_MODEL_H
+
+#include <array>
+#include <string>
+#include <nlohmann/json.hpp>
+
+#include "Instance.h"
+
+enum ENGINE{ALL, STL, RADIX, REVISITED, AUTO, PERMUTATION, CMAX_ONLY}; // engine used to solve an instance, ALL runs every engine for benchmarking
+
+/**
+ * Cheap features of an instance, computed during the split pass of the jobs into the sets A and B.
+ */
+struct InstanceFeatures {
+    size_t n = 0;
+    size_t nbA = 0;
+    size_t nbB = 0;
+    bool prop2 = false;
+    bool prop3 = false;
+    bool prop5 = false;
+    bool prop6 = false;
+};
+
+class CostModel {
+    // Each engine is modelled by a linear cost t = coef[0] * n + coef[1] * x, where x is the sorting work of the engine:
+    // - STL: x = |A| log2 |A| + |B| log2 |B|
+    // - Radix: x = 0, the number of passes is absorbed in the per job cost
+    // - Revisited: x = |A| log2 |A| + |B| log2 |B| only if no proposition holds, 0 otherwise (only a prefix is sorted)
+    // Default coefficients (in seconds) are only a rough guess, run a calibration to fit them on the host machine.
+    std::array<double,2> coefSTL{2.0E-9,4.0E-9};
+    std::array<double,2> coefRadix{2.0E-8,0.0};
+    std::array<double,2> coefRevisited{3.0E-9,6.0E-9};
+
+    static double sortingWork(const InstanceFeatures &features);
+
+    [[nodiscard]] nlohmann::json toJson() const;
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    CostModel() = default;
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that computes the features of an instance. The sets A and B and the sums of processing times must be already
+     * computed, i.e. Instance::splitJobsRevisitedJohnson must be called before.
+     * @param instance The instance
+     * @return The features of the instance
+     */
+    static InstanceFeatures computeFeatures(Instance &instance);
+
+    /**
+     * Method that estimates the running time of an engine on an instance.
+     * @param engine The engine (STL, RADIX or REVISITED)
+     * @param features The features of the instance
+     * @return The estimated time in seconds
+     */
+    [[nodiscard]] double estimateCost(ENGINE engine, const InstanceFeatures &features) const;
+
+    /**
+     * Method that selects the engine with the smallest estimated cost.
+     * @param features The features of the instance
+     * @param allowRevisited If false, the revisited engine is not a candidate
+     * @return The selected engine
+     */
+    [[nodiscard]] ENGINE selectEngine(const InstanceFeatures &features, bool allowRevisited = true) const;
+
+    /**
+     * Method that fits the coefficients of the model by running each engine on generated instances. The JSON object
+     * may contain the attributes "seed", "n", "pmax", "distributions" and "repetitions", see README file.
+     * @param paramCalibration The JSON object of parameters
+     */
+    void calibrate(const nlohmann::json &paramCalibration);
+
+    /**
+     * Method that loads the coefficients from a JSON file written by CostModel::saveToFile.
+     * @param filePath The path of the file
+     */
+    void loadFromFile(const std::string &filePath);
+
+    /**
+     * Method that saves the coefficients in a JSON file.
+     * @param filePath The path of the file
+     */
+    void saveToFile(const std::string &filePath) const;
+
+    /**
+     * Method that loads the coefficients from a file or, if the file does not exist, runs a calibration with default
+     * parameters and saves it. Hence, the benchmark is run only once on a host machine.
+     * @param filePath The path of the calibration file
+     */
+    void loadOrCalibrate(const std::string &filePath);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    /**
+     * Method that gives the coefficients of the model in effect, in the JSON format of the calibration file.
+     * @return The coefficients of the engines on one line
+     */
+    [[nodiscard]] std::string getCoefficients() const;
+
+    static std::string getEngineName(ENGINE engine);
+
+    static ENGINE getEngineFromName(const std::string &engineName);
+};
+
+#endif //F2_CMAX_COST_MODEL_H
@@ -0,0 +1,128 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_EXTERNAL_SOLVER_H
+#define F2_CMAX_EXTERNAL_SOLVER_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Solver for instances that do not fit in memory. The instance file is streamed once to split the jobs into the sets A
+ * and B, each set is written in sorted runs on disk (external run formation) and the runs are merged in Johnson's order
+ * while the makespan is computed on the fly. The memory used by the jobs never exceeds the memory budget.
+ */
+class ExternalSolver {
+public:
+    // A job on disk, the id is the index of the job in the instance file
+    struct Record {
+        double first;
+        double second;
+        uint64_t id;
+    };
+
+private:
+    Instance metadata; // name and path of the instance, no job is stored in it
+    uint64_t nbJobs = 0;
+    size_t memoryBudget = 256UL << 20; // in bytes
+    std::filesystem::path tmpDir;
+    std::filesystem::path workingDir; // unique directory in tmpDir for the runs of this instance
+    std::filesystem::path scheduleDir; // if empty, the schedule is not written
+    std::vector<std::filesystem::path> runsA;
+    std::vector<std::filesystem::path> runsB;
+    size_t nbRuns = 0; // total number of runs, including the intermediate ones
+    std::chrono::duration<double> time_elapsed_run_formation{};
+    std::chrono::duration<double> time_elapsed_merge_evaluate{};
+    double objective = 0.0;
+
+    /**
+     * Method that sorts a buffer in Johnson's order of its set and writes it as a new run.
+     * @param buffer The buffer of jobs, it is cleared
+     * @param runs The list of runs of the set
+     * @param setName The name of the set ("A" or "B")
+     */
+    void spillRun(std::vector<Record> &buffer, std::vector<std::filesystem::path> &runs, const std::string &setName);
+
+    /**
+     * Method that merges the runs of a set until their number is smaller than the fan-in allowed by the memory budget.
+     * @param runs The list of runs of the set
+     * @param setName The name of the set ("A" or "B")
+     */
+    void reduceRuns(std::vector<std::filesystem::path> &runs, const std::string &setName);
+
+    [[nodiscard]] size_t getMaxFanIn() const;
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the solver.
+     * @param instancePath The path of the instance file
+     * @param memoryBudget The number of bytes that the jobs may use in memory
+     * @param tmpDir The directory where the runs are written
+     */
+    ExternalSolver(std::string &instancePath, size_t memoryBudget, const std::filesystem::path &tmpDir);
+
+    ~ExternalSolver();
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that computes the optimal makespan, and writes the schedule if a path was set.
+     */
+    void solve();
+
+    void printOutput(std::string &fileOutputName, std::ofstream &outputFile);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] double getObjective() const { return objective; }
+
+    [[nodiscard]] uint64_t getNbJobs() const { return nbJobs; }
+
+    /********************/
+    /*      SETTER      */
+    /********************/
+
+    /**
+     * Setter of the directory where the schedule is written, in the file named by Instance::getScheduleFileName once the
+     * name of the instance is read.
+     * @param newScheduleDir The directory
+     */
+    void setScheduleDir(const std::filesystem::path &newScheduleDir) { scheduleDir = newScheduleDir; }
+};
+
+#endif //F2_CMAX_EXTERNAL_SOLVER_H
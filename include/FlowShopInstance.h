@@ -0,0 +1,139 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_FLOW_SHOP_INSTANCE_H
+#define F2_CMAX_FLOW_SHOP_INSTANCE_H
+
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Instance of the permutation flow shop Fm|prmu|Cmax. The file format is the one of Instance with an attribute "m:"
+ * giving the number of machines, each job line has then m processing times separated by '\t'. Without this attribute,
+ * the instance has two machines.
+ */
+class FlowShopInstance {
+    std::string instanceName;
+    std::filesystem::path instancePath; // the path to the instance
+    unsigned int nbJobs = 0;
+    unsigned int nbMachines = 2;
+    double supPj = 100.0;
+    std::vector<double> processingTimes; // the processing time of job j on machine i is at j * nbMachines + i
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    FlowShopInstance() = default;
+
+    /**
+     * Constructor by instance's path.
+     * @param newInstancePath The path to set
+     */
+    explicit FlowShopInstance(const std::string &newInstancePath);
+
+    /**
+     * Constructor of the two-machine flow shop of an instance of F2||Cmax, the jobs are in the current order of its list
+     * with their processing times in the order of the machines, even if the instance is split.
+     * @param twoMachineInstance The instance whose jobs are copied
+     */
+    explicit FlowShopInstance(const Instance &twoMachineInstance);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that adds a job at the end of the instance.
+     * @param jobProcessingTimes The processing time of the job on each machine, there must be nbMachines of them
+     */
+    void addJob(std::span<const double> jobProcessingTimes);
+
+    /**
+     * Method that builds the two-machine instance of the CDS heuristic for k: a job has the sum of its processing times
+     * on the first k machines on M1 and on the last k machines on M2. The jobs keep their index.
+     * @param k The number of machines aggregated, between 1 and nbMachines-1
+     * @param twoMachineInstance The instance to fill
+     */
+    void buildCDSInstance(unsigned int k, Instance &twoMachineInstance) const;
+
+    /**
+     * Method that generates the jobs of an instance. The parameters are the ones of Instance::generateInstance with the
+     * number of machines "m".
+     * @param paramInstance The parameters of the instance
+     * @param generator The instance whose random generator and law are used to draw the processing times
+     */
+    void generateInstance(nlohmann::json &paramInstance, Instance &generator);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] const std::filesystem::path &getInstancePath() const { return instancePath; }
+
+    [[nodiscard]] const std::string &getInstanceName() const { return instanceName; }
+
+    [[nodiscard]] unsigned int getNbJobs() const { return nbJobs; }
+
+    [[nodiscard]] unsigned int getNbMachines() const { return nbMachines; }
+
+    [[nodiscard]] double getSupPj() const { return supPj; }
+
+    [[nodiscard]] size_t getNbAddedJobs() const { return processingTimes.size() / nbMachines; }
+
+    [[nodiscard]] double getProcessingTime(size_t job, size_t machine) const { return processingTimes[job * nbMachines + machine]; }
+
+    /**
+     * Getter of the processing times of a job on every machine.
+     */
+    [[nodiscard]] std::span<const double> getJob(size_t job) const {
+        return std::span<const double>(processingTimes).subspan(job * nbMachines, nbMachines);
+    }
+
+    /********************/
+    /*      SETTER      */
+    /********************/
+
+    void setInstanceName(const std::string &newInstanceName);
+
+    void setInstancePath(const std::string &newInstancePath);
+
+    void setNbJobs(unsigned int newNbJobs) {
+        nbJobs = newNbJobs;
+        processingTimes.reserve(static_cast<size_t>(nbJobs) * nbMachines);
+    }
+
+    /**
+     * Setter of the number of machines, it must be set before adding jobs.
+     */
+    void setNbMachines(unsigned int newNbMachines);
+};
+
+#endif //F2_CMAX_FLOW_SHOP_INSTANCE_H
@@ -0,0 +1,107 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_FLOW_SHOP_SOLVER_H
+#define F2_CMAX_FLOW_SHOP_SOLVER_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "FlowShopInstance.h"
+
+/**
+ * Solver of the permutation flow shop Fm|prmu|Cmax. The CDS heuristic solves with Johnson's rule the m-1 two-machine
+ * instances built by aggregating the machines, and keeps the best sequence. This sequence gives the order in which the
+ * NEH heuristic inserts the jobs. Each insertion tries every position with Taillard's acceleration: the heads and the
+ * tails of the partial sequence are computed once, then a position is evaluated in O(m), so an insertion is O(km) for
+ * a partial sequence of k jobs. The positions are split between the threads.
+ */
+class FlowShopSolver {
+    FlowShopInstance *instance = nullptr;
+    unsigned int nbThreads = 1;
+    std::vector<uint32_t> sequenceCDS; // best sequence of the CDS heuristic
+    std::vector<uint32_t> sequence; // sequence of the NEH heuristic
+    double objectiveCDS = 0.0;
+    double objective = 0.0;
+    std::chrono::duration<double> time_elapsed_CDS{};
+    std::chrono::duration<double> time_elapsed_NEH{};
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the solver.
+     * @param instance The instance to solve
+     * @param nbThreads The number of threads used by the NEH heuristic
+     */
+    explicit FlowShopSolver(FlowShopInstance *instance, unsigned int nbThreads = 1);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that runs the CDS heuristic and the NEH heuristic seeded by its sequence, both are timed.
+     */
+    void solve();
+
+    /**
+     * Method that computes the best sequence of the CDS heuristic, each two-machine instance is solved by the engine
+     * PERMUTATION of Solver, which gives the sequence in the numbering of the jobs.
+     */
+    void CDS();
+
+    /**
+     * Method that computes the sequence of the NEH heuristic, the jobs are inserted in the order of the CDS sequence.
+     */
+    void NEH();
+
+    /**
+     * Method that computes the makespan of a sequence in O(nm).
+     * @param sequenceToEvaluate The indices of the jobs in the order of the sequence
+     */
+    [[nodiscard]] double evaluate(std::span<const uint32_t> sequenceToEvaluate) const;
+
+    void printOutput(std::string &fileOutputName, std::ofstream &outputFile);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] double getObjective() const { return objective; }
+
+    [[nodiscard]] double getObjectiveCDS() const { return objectiveCDS; }
+
+    [[nodiscard]] const std::vector<uint32_t> &getSequence() const { return sequence; }
+
+    [[nodiscard]] const std::vector<uint32_t> &getSequenceCDS() const { return sequenceCDS; }
+};
+
+#endif //F2_CMAX_FLOW_SHOP_SOLVER_H
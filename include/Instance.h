@@ -29,23 +29,52 @@
 #include <filesystem>
 #include <nlohmann/json.hpp>
 #include <random>
+#include <span>
 #include <vector>
 
 #include "F2CmaxException.h"
+#include "JobAllocator.h"
+#include "Trace.h"
 
 enum LAW{UNIFORM, NEGATIVE_BINOMIAL, GEOMETRIC,POISSON,EXPONENTIAL, GAMMA,WEIBULL,LOGNORMAL }; // law uses to generates processing times
 class Instance {
 public:
     typedef std::pair<double,double> Job;
 
+    // The sums and the maximums of processing times of the sets A and B, computed while splitting the jobs
+    struct SplitSums {
+        double p_max_A = 0.0;
+        double p_max_B = 0.0;
+        double p_max = 0.0;
+        double sumPA1 = 0.0;
+        double sumPA2 = 0.0;
+        double sumPB1 = 0.0;
+        double sumPB2 = 0.0;
+
+        void merge(const SplitSums &other) {
+            p_max_A = std::max(p_max_A, other.p_max_A);
+            p_max_B = std::max(p_max_B, other.p_max_B);
+            p_max = std::max(p_max, other.p_max);
+            sumPA1 += other.sumPA1;
+            sumPA2 += other.sumPA2;
+            sumPB1 += other.sumPB1;
+            sumPB2 += other.sumPB2;
+        }
+    };
+
 private:
-    std::vector<Job> listJobs;
+    // The jobs of the instance, in the order of the file until they are split. Once split, the set A is in place at the
+    // beginning of the list and the set B at the end, with the processing times of its jobs swapped (reverse property).
+    std::vector<Job, JobAllocator<Job>> listJobs;
     double supPj = 100.0;
     std::string instanceName;
     std::filesystem::path instancePath; // the path to the instance
     unsigned int nbJobs=0; // the nb of job
-    std::vector<Job> jobsSmallerOnM1;
-    std::vector<Job> jobsSmallerOnM2;
+    size_t nbJobsA = 0; // size of the set A at the beginning of listJobs
+    size_t nbJobsB = 0; // size of the set B after the set A in listJobs
+    bool machinesSwapped = false; // if true, the set of jobs smaller on M1 is the set B and vice versa
+    bool splitWhileReading = false; // if true, the jobs were split and summed while they were added
+    bool fileOrder = true; // if false, the jobs were moved by a split and are no longer in the order of the file
     // the seed use for generate instance
     std::mt19937 numGenerator;
     LAW distribution=UNIFORM;
@@ -71,18 +100,42 @@ public:
      */
     explicit Instance(std::string &newInstancePath);
 
+    /**
+     * Method that empties the instance to fill it with other jobs. The capacity of the list of jobs and the random
+     * generator are kept, so that a reused instance does not allocate again.
+     */
+    void reset();
+
+    /**
+     * Method that empties the instance to fill it with the jobs of another file.
+     * @see Instance::reset()
+     * @param newInstancePath The path of the new instance
+     */
+    void reset(const std::string &newInstancePath);
+
     /**
      * Method that swap machine if we have P1 > P2
      */
     void swapMachines() {
-        std::swap(jobsSmallerOnM2,jobsSmallerOnM1);
+        machinesSwapped = !machinesSwapped;
+        splitWhileReading = false;
         std::swap(sumPA1,sumPA2);
         std::swap(sumPB1,sumPB2);
         std::swap(p_max_A,p_max_B);
     }
 
+    /**
+     * Method that undoes the split of jobs into the sets A and B and resets the sums of processing times. The jobs of B
+     * get back their processing times, but the list of jobs is not in the order before the split: isInFileOrder stays
+     * false until the instance is reset.
+     */
     void clearListJobs() {
-        jobsSmallerOnM1.clear(); jobsSmallerOnM2.clear();
+        TRACE_SCOPE("Instance::clearListJobs");
+        for (auto &job : std::span<Job>(listJobs).subspan(nbJobsA, nbJobsB)) std::swap(job.first, job.second);
+        nbJobsA = 0;
+        nbJobsB = 0;
+        machinesSwapped = false;
+        splitWhileReading = false;
         p_max_A = 0.0;
         p_max_B = 0.0;
         p_max = 0.0;
@@ -96,23 +149,58 @@ public:
         listJobs.emplace_back(pi1, pi2);
     }
 
-    void addJobOnMachinesJohnson(double pi1, double pi2) {
+    /**
+     * Method that adds a job directly in its set, as splitJobsRevisitedJohnson would do: a job of A is swapped with the
+     * first job of B, a job of B is appended with its processing times swapped. The jobs added before must have been
+     * added by this method, so that the instance is split and summed once all jobs are read.
+     * @param pi1 The processing time on the first machine
+     * @param pi2 The processing time on the second machine
+     */
+    void addJobSplitRevisitedJohnson(double pi1, double pi2) {
+        splitWhileReading = true;
+        fileOrder = false;
+        p_max = std::max(p_max,std::max(pi1,pi2));
         if (pi1<pi2) {
-            jobsSmallerOnM1.emplace_back(pi1,pi2);
+            listJobs.emplace_back(pi1, pi2);
+            std::swap(listJobs.back(), listJobs[nbJobsA++]);
+            p_max_A = std::max(p_max_A,pi1);
+            sumPA1 += pi1;
+            sumPA2 += pi2;
         }
         else {
-            jobsSmallerOnM2.emplace_back(pi2,pi1); //add the job directly regarding the reverse property
+            listJobs.emplace_back(pi2, pi1);
+            p_max_B = std::max(p_max_B,pi2);
+            sumPB1 += pi2;
+            sumPB2 += pi1;
         }
+        nbJobsB = listJobs.size() - nbJobsA;
+    }
+
+    /**
+     * Method that splits in place the jobs in the sets A and B: the jobs with p1 < p2 are moved at the beginning of the
+     * list, the other ones stay after them with their processing times swapped (reverse property). The jobs must not be
+     * already split.
+     */
+    void splitJobsJohnson() {
+        TRACE_SCOPE("Instance::splitJobsJohnson");
+        fileOrder = false;
+        nbJobsA = 0;
+        for (auto &job : listJobs) {
+            if (job.first < job.second) std::swap(job, listJobs[nbJobsA++]);
+            else std::swap(job.first, job.second); //add the job directly regarding the reverse property
+        }
+        nbJobsB = listJobs.size() - nbJobsA;
     }
 
     void addJobOnMachinesRevisitedJohnson() {
-        for (auto & [pi1,pi2]: jobsSmallerOnM1) {
+        TRACE_SCOPE("Instance::addJobOnMachinesRevisitedJohnson");
+        for (auto & [pi1,pi2]: getJobsSmallerOnM1()) {
             p_max = std::max(p_max,std::max(pi1,pi2));
             p_max_A = std::max(p_max_A,pi1);
             sumPA1 += pi1;
             sumPA2 += pi2;
         }
-        for (auto & [pi2,pi1]: jobsSmallerOnM2) {
+        for (auto & [pi2,pi1]: getJobsSmallerOnM2()) {
             p_max = std::max(p_max,std::max(pi1,pi2));
             p_max_B = std::max(p_max_B,pi2);
             sumPB1 += pi2;
@@ -120,6 +208,64 @@ public:
         }
     }
 
+    /**
+     * Method that splits in place the jobs in the sets A and B and computes the sums of processing times in one pass
+     * over the list of jobs. It is equivalent to call splitJobsJohnson and then addJobOnMachinesRevisitedJohnson.
+     */
+    void splitJobsRevisitedJohnson() {
+        TRACE_SCOPE("Instance::splitJobsRevisitedJohnson");
+        fileOrder = false;
+        nbJobsA = 0;
+        for (auto &job : listJobs) {
+            auto [pi1,pi2] = job;
+            p_max = std::max(p_max,std::max(pi1,pi2));
+            if (pi1<pi2) {
+                std::swap(job, listJobs[nbJobsA++]);
+                p_max_A = std::max(p_max_A,pi1);
+                sumPA1 += pi1;
+                sumPA2 += pi2;
+            }
+            else {
+                job = {pi2,pi1};
+                p_max_B = std::max(p_max_B,pi2);
+                sumPB1 += pi2;
+                sumPB2 += pi1;
+            }
+        }
+        nbJobsB = listJobs.size() - nbJobsA;
+    }
+
+    /**
+     * Method that resizes the list of jobs, so that it is filled in place (for example by several threads). The jobs must
+     * not be split.
+     * @param newNbJobs The number of jobs in the list
+     * @return The list of jobs to fill
+     */
+    std::span<Job> resizeListJobs(size_t newNbJobs) {
+        listJobs.resize(newNbJobs);
+        return listJobs;
+    }
+
+    /**
+     * Method that marks the list of jobs as already split: the set A is its nbJobsA first jobs and the set B the other
+     * ones, with their processing times swapped, as after splitJobsRevisitedJohnson.
+     * @param newNbJobsA The number of jobs of the set A
+     * @param sums The sums and the maximums of processing times of both sets
+     */
+    void setSplitWhileReading(size_t newNbJobsA, const SplitSums &sums) {
+        splitWhileReading = true;
+        fileOrder = false;
+        nbJobsA = newNbJobsA;
+        nbJobsB = listJobs.size() - nbJobsA;
+        p_max_A = sums.p_max_A;
+        p_max_B = sums.p_max_B;
+        p_max = sums.p_max;
+        sumPA1 = sums.sumPA1;
+        sumPA2 = sums.sumPA2;
+        sumPB1 = sums.sumPB1;
+        sumPB2 = sums.sumPB2;
+    }
+
     Job generateJob(unsigned int infPi, unsigned int supPi);
 
     void generateInstance(nlohmann::json &paramInstance);
@@ -132,6 +278,13 @@ public:
 
     [[nodiscard]] const std::string &getInstanceName() const { return instanceName; }
 
+    /**
+     * Getter of the name of the file of the schedule of the instance, the same for the in-memory and the out-of-core
+     * solvers: the name of the instance (its attribute "name", otherwise the stem of its path) followed by "_schedule.txt".
+     * @return The name of the file
+     */
+    [[nodiscard]] std::string getScheduleFileName() const { return instanceName + "_schedule.txt"; }
+
     [[nodiscard]] unsigned int getNbJobs() const { return nbJobs; }
     [[nodiscard]] double getSupPj() const { return supPj; }
 
@@ -144,13 +297,51 @@ public:
     [[nodiscard]] double getSumPb1() { return sumPB1; }
     [[nodiscard]] double getSumPb2() { return sumPB2; }
 
-    [[nodiscard]] std::vector<Job> getListJobs() const { return listJobs; }
+    [[nodiscard]] std::span<const Job> getListJobs() const { return listJobs; }
+
+    /**
+     * Getter of the processing times of a job of the list on the first and on the second machine: the times of a job of
+     * the set B, swapped in the list, are swapped back.
+     * @param indexJob The index of the job in the list of jobs
+     */
+    [[nodiscard]] Job getJob(size_t indexJob) const {
+        const Job &job = listJobs[indexJob];
+        if (indexJob >= nbJobsA && indexJob < nbJobsA + nbJobsB) return {job.second, job.first};
+        return job;
+    }
+
+    /**
+     * Getter of the flag telling if the jobs were split into the sets A and B while they were read, in this case the
+     * solver does not split them again.
+     */
+    [[nodiscard]] bool isSplitWhileReading() const { return splitWhileReading; }
+
+    /**
+     * Getter of the flag telling if the list of jobs is in the order of the file: it is false once the jobs were split,
+     * even if the split was undone by clearListJobs, so the indices in the list are no longer the ids of the jobs.
+     */
+    [[nodiscard]] bool isInFileOrder() const { return fileOrder; }
+
+    /**
+     * Getter of the set of jobs smaller on the first machine, it is a view over the list of jobs.
+     */
+    [[nodiscard]] std::span<Job> getJobsSmallerOnM1() {
+        return std::span<Job>(listJobs).subspan(machinesSwapped ? nbJobsA : 0, machinesSwapped ? nbJobsB : nbJobsA);
+    }
 
-    [[nodiscard]] std::vector<Job> & getJobsSmallerOnM1() { return jobsSmallerOnM1; }
-    [[nodiscard]] std::vector<Job> & getJobsSmallerOnM2() { return jobsSmallerOnM2; }
+    /**
+     * Getter of the set of jobs smaller on the second machine, with the reverse property, it is a view over the list of jobs.
+     */
+    [[nodiscard]] std::span<Job> getJobsSmallerOnM2() {
+        return std::span<Job>(listJobs).subspan(machinesSwapped ? 0 : nbJobsA, machinesSwapped ? nbJobsA : nbJobsB);
+    }
 
-    [[nodiscard]] std::vector<Job> getJobsSmallerOnM1() const { return jobsSmallerOnM1; }
-    [[nodiscard]] std::vector<Job> getJobsSmallerOnM2() const { return jobsSmallerOnM2; }
+    [[nodiscard]] std::span<const Job> getJobsSmallerOnM1() const {
+        return std::span<const Job>(listJobs).subspan(machinesSwapped ? nbJobsA : 0, machinesSwapped ? nbJobsB : nbJobsA);
+    }
+    [[nodiscard]] std::span<const Job> getJobsSmallerOnM2() const {
+        return std::span<const Job>(listJobs).subspan(machinesSwapped ? 0 : nbJobsA, machinesSwapped ? nbJobsA : nbJobsB);
+    }
 
     /********************/
     /*      SETTER      */
@@ -185,17 +376,27 @@ public:
         instanceName = instancePath.stem();
     }
 
+    /**
+     * Setter of the path and the name of an instance read from a stream (stdin, pipe...), the file system is not used.
+     * @param streamName The name of the stream, for example "stdin"
+     */
+    void setStreamPath(const std::string &streamName) {
+        instancePath = streamName;
+        instanceName = streamName;
+    }
+
     void setSeed(unsigned int seed) { numGenerator = std::mt19937(seed); }
 
+    /**
+     * Setter of the law used by generateJob.
+     * @param distributionName The name of the law (uniform,negative_binomial,geometric,poisson,exponential,gamma,weibull,lognormal)
+     */
+    void setDistribution(const std::string &distributionName);
+
     void setNbJobs(unsigned int nbJobs) {
         this->nbJobs = nbJobs;
         listJobs.reserve(nbJobs);
-        jobsSmallerOnM1.reserve(nbJobs);
-        jobsSmallerOnM2.reserve(nbJobs);
     }
-
-    void setJobsSmallerOnM1(const std::vector<Job>& jobsSmallerOnM1) { this->jobsSmallerOnM1 = jobsSmallerOnM1; }
-    void setJobsSmallerOnM2(const std::vector<Job>& jobsSmallerOnM2) { this->jobsSmallerOnM2 = jobsSmallerOnM2; }
 };
 
 inline std::ostream &operator<<(std::ostream &os, const Instance &instance) {
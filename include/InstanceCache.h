@@ -0,0 +1,103 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_INSTANCE_CACHE_H
+#define F2_CMAX_INSTANCE_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+#include "Instance.h"
+#include "Parser.h"
+
+/**
+ * Cache of parsed instances, so that an instance file solved by several methods, or by several configs, is parsed once.
+ * An instance is keyed by its path and the time of the last modification of its file: a file modified since it was
+ * parsed is parsed again. A file parsed by several threads which split its jobs into the sets A and B is cached apart from
+ * the same file in the order of its jobs. The cached instances are read-only, the solvers work on a copy of their jobs. When the jobs of
+ * the cached instances use more than the capacity, the least recently used instances are dropped.
+ */
+class InstanceCache {
+    struct Entry {
+        std::filesystem::file_time_type lastWriteTime;
+        Instance instance;
+        uint64_t lastUse = 0;
+    };
+
+    std::unordered_map<std::string, Entry> entries; // keyed by the normalized path of the file, followed by '\0' if split
+    size_t capacity; // in bytes of jobs
+    size_t nbBytes = 0; // bytes of jobs of the cached instances
+    uint64_t nbUses = 0;
+    size_t nbHits = 0;
+    size_t nbMisses = 0;
+
+    static size_t getNbBytes(const Instance &instance) { return instance.getListJobs().size() * sizeof(Instance::Job); }
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the cache.
+     * @param capacity The number of bytes of jobs that the cached instances may use, the last used instance is always kept
+     */
+    explicit InstanceCache(size_t capacity = 1UL << 30) : capacity(capacity) {}
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that gives the instance of a file, it is parsed if it is not in the cache or if the file was modified. The
+     * jobs are in the order of the file, unless they are split while parsed. The reference is valid until the next call.
+     * @param filePath The path of the instance file
+     * @param parser The parser of the file
+     * @param parserThreads The number of threads used to parse the file (see Parser::readFromFileParallel)
+     * @param splitWhileParsing If true and parserThreads is greater than 1, the threads split the jobs into the sets A
+     * and B while they parse them
+     * @return The cached instance
+     */
+    const Instance &get(std::string &filePath, const Parser &parser, unsigned int parserThreads, bool splitWhileParsing);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] size_t getNbHits() const { return nbHits; }
+
+    [[nodiscard]] size_t getNbMisses() const { return nbMisses; }
+
+    [[nodiscard]] size_t getNbBytes() const { return nbBytes; }
+
+    /********************/
+    /*      SETTER      */
+    /********************/
+
+    void setCapacity(size_t newCapacity) { capacity = newCapacity; }
+};
+
+#endif //F2_CMAX_INSTANCE_CACHE_H
@@ -0,0 +1,101 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_INSTANCE_POOL_H
+#define F2_CMAX_INSTANCE_POOL_H
+
+#include <memory>
+#include <vector>
+
+#include "Instance.h"
+
+/**
+ * Pool of reusable instances for batch runs. An instance given back to the pool keeps the capacity of its list of jobs
+ * and its random generator, so that solving many instances of similar size reuses the same pages instead of allocating
+ * and faulting in new ones. The last released instance is handed out first, its memory is the most likely in cache.
+ */
+class InstancePool {
+    std::vector<std::unique_ptr<Instance>> freeInstances;
+    size_t nbCreated = 0; // number of instances constructed by the pool
+
+public:
+    /**
+     * An instance taken from the pool, it is given back to the pool when destroyed.
+     */
+    class Lease {
+        InstancePool *pool = nullptr;
+        std::unique_ptr<Instance> instance;
+
+    public:
+        Lease(InstancePool *pool, std::unique_ptr<Instance> instance) : pool(pool), instance(std::move(instance)) {}
+
+        Lease(Lease &&other) noexcept = default;
+
+        Lease &operator=(Lease &&other) noexcept;
+
+        Lease(const Lease &) = delete;
+
+        Lease &operator=(const Lease &) = delete;
+
+        ~Lease();
+
+        Instance *get() const { return instance.get(); }
+
+        Instance *operator->() const { return instance.get(); }
+
+        Instance &operator*() const { return *instance; }
+    };
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    InstancePool() = default;
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that takes an instance from the pool, a new one is constructed if the pool is empty. The instance still has
+     * the jobs of its previous use, Parser::readFromFile(std::string&, Instance&) resets it.
+     * @return The lease of the instance
+     */
+    Lease acquire();
+
+    /**
+     * Method that gives back an instance to the pool.
+     * @param instance The instance to give back
+     */
+    void release(std::unique_ptr<Instance> instance);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] size_t getNbCreated() const { return nbCreated; }
+
+    [[nodiscard]] size_t getNbFree() const { return freeInstances.size(); }
+};
+
+#endif //F2_CMAX_INSTANCE_POOL_H
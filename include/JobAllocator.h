@@ -0,0 +1,100 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_JOB_ALLOCATOR_H
+#define F2_CMAX_JOB_ALLOCATOR_H
+
+#include <cstddef>
+#include <string>
+
+enum HUGE_PAGES{NO_HUGE_PAGES, TRANSPARENT_HUGE_PAGES, EXPLICIT_HUGE_PAGES}; // pages backing the large job arrays
+enum NUMA_POLICY{NO_NUMA, NUMA_INTERLEAVE, NUMA_FIRST_TOUCH}; // placement of the pages of the large job arrays on the NUMA nodes
+
+/**
+ * Allocation policy of the large arrays of jobs (the list of jobs of an instance and the scratch buffers of the sorts).
+ * An array of at least MIN_MAPPED_BYTES is mapped directly, whatever the policy, so that it is released in the same way
+ * if the policy changed in between. The policy only changes how its pages are backed and placed:
+ * - hugePages: transparent huge pages (madvise) or explicit huge pages (MAP_HUGETLB, from the pool reserved by the
+ *   system administrator, or transparent ones if the pool is empty), to reduce the TLB misses of the sorts.
+ * - numa: the pages are interleaved on all the nodes (mbind), or faulted in by several threads, each one touching a
+ *   contiguous slice, so that the slices land on the nodes of the threads (first touch).
+ * The policy is global to the process and is set once from the config.
+ */
+class AllocationPolicy {
+    static HUGE_PAGES hugePages;
+    static NUMA_POLICY numa;
+    static unsigned int nbTouchThreads;
+
+public:
+    static constexpr size_t MIN_MAPPED_BYTES = 2UL << 20; // size of a huge page on x86-64
+
+    /**
+     * Method that allocates the memory of an array with the policy.
+     * @param bytes The size of the array in bytes
+     * @return The memory of the array
+     */
+    static void *allocate(size_t bytes);
+
+    /**
+     * Method that releases the memory of an array allocated by AllocationPolicy::allocate.
+     * @param pointer The memory of the array
+     * @param bytes The size of the array in bytes, as given to allocate
+     */
+    static void deallocate(void *pointer, size_t bytes) noexcept;
+
+    /**
+     * Method that gives the name of the policy, as written in the results ("default", "transparent", "explicit",
+     * followed by "+interleave" or "+firstTouch" with a NUMA policy).
+     */
+    static std::string getName();
+
+    static void setHugePages(HUGE_PAGES newHugePages) { hugePages = newHugePages; }
+
+    static void setNuma(NUMA_POLICY newNuma) { numa = newNuma; }
+
+    static void setNbTouchThreads(unsigned int newNbTouchThreads) { nbTouchThreads = newNbTouchThreads; }
+};
+
+/**
+ * Allocator of the job arrays, with the policy of AllocationPolicy. The small arrays are allocated by operator new.
+ */
+template<class T>
+class JobAllocator {
+public:
+    typedef T value_type;
+
+    JobAllocator() noexcept = default;
+
+    template<class U>
+    JobAllocator(const JobAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n) { return static_cast<T *>(AllocationPolicy::allocate(n * sizeof(T))); }
+
+    void deallocate(T *pointer, size_t n) noexcept { AllocationPolicy::deallocate(pointer, n * sizeof(T)); }
+
+    template<class U>
+    bool operator==(const JobAllocator<U> &) const noexcept { return true; }
+};
+
+#endif //F2_CMAX_JOB_ALLOCATOR_H
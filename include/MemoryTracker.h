@@ -0,0 +1,147 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_MEMORY_TRACKER_H
+#define F2_CMAX_MEMORY_TRACKER_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Memory used by a phase of a run: the bytes and the number of allocations done in the phase, and the peak of the heap
+ * in the phase above its size at the start of the phase.
+ */
+struct MemoryUsage {
+    size_t allocatedBytes = 0;
+    size_t nbAllocations = 0;
+    size_t peakBytes = 0;
+};
+
+/**
+ * Accounting of the heap of the process. The global operators new and delete are replaced (see MemoryTracker.cpp) to
+ * count the allocations and the bytes in use, with relaxed atomic counters, so that the totals include the allocations
+ * of all threads. The job arrays mapped directly by AllocationPolicy are counted too. Each thread has also its own
+ * account, a phase is measured by a Scope on the account of its thread, so the phases of the threads of a pipeline do
+ * not see the allocations of each other. A helper thread which works for a phase of another thread is attached to the
+ * account of this thread by an Attach.
+ */
+class MemoryTracker {
+public:
+    /**
+     * Counters of the allocations of a thread and of the helper threads attached to it. A thread may release the memory
+     * allocated by another one, so the bytes in use of an account may be negative.
+     */
+    struct Account {
+        std::atomic<size_t> allocatedBytes{0};
+        std::atomic<size_t> nbAllocations{0};
+        std::atomic<long> liveBytes{0};
+        std::atomic<long> peakLiveBytes{0};
+    };
+
+    /**
+     * Measure of the phase between the construction and the destruction of the scope, it is added to a usage. The
+     * scopes of a thread must be nested: a scope is destroyed by the thread which has constructed it, before the scopes
+     * constructed before it (checked by assertions). The helper threads attached to the account must not allocate
+     * while a scope is constructed or destroyed, they are usually joined or waiting between the phases.
+     */
+    class Scope {
+        MemoryUsage &usage;
+        Account &account;
+        const Scope *outerScope; // innermost scope of the thread before this one
+        size_t startAllocatedBytes;
+        size_t startNbAllocations;
+        long startLiveBytes;
+        long outerPeakBytes; // peak of the account before the scope, restored at its end for the outer scopes
+
+    public:
+        explicit Scope(MemoryUsage &usage);
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope();
+    };
+
+    /**
+     * Attachment of the calling thread to the account of another thread, from the construction to the destruction, so
+     * that the allocations of the calling thread are counted in the scopes of the other thread.
+     */
+    class Attach {
+        Account *previousAccount;
+
+    public:
+        explicit Attach(Account &account);
+
+        Attach(const Attach &) = delete;
+
+        Attach &operator=(const Attach &) = delete;
+
+        ~Attach();
+    };
+
+    /**
+     * Method that gives the account of the calling thread, or the account it is attached to.
+     */
+    static Account &getAccount();
+
+    /**
+     * Method that gives the total number of bytes allocated since the start of the process.
+     */
+    static size_t getAllocatedBytes();
+
+    /**
+     * Method that gives the total number of allocations since the start of the process.
+     */
+    static size_t getNbAllocations();
+
+    /**
+     * Method that gives the number of bytes of the heap in use.
+     */
+    static size_t getLiveBytes();
+
+    /**
+     * Method that counts an allocation mapped directly (see AllocationPolicy), which does not go through operator new.
+     * @param bytes The size of the mapping
+     */
+    static void countMapping(size_t bytes);
+
+    /**
+     * Method that counts the release of an allocation counted by MemoryTracker::countMapping.
+     * @param bytes The size of the mapping
+     */
+    static void countUnmapping(size_t bytes);
+
+    /**
+     * Method that gives the peak resident set size of the process in bytes (VmHWM).
+     */
+    static size_t getPeakRSS();
+
+    /**
+     * Method that resets the peak resident set size of the process to its current resident set size, so that
+     * getPeakRSS gives the peak of the next phase. It needs Linux 4.0 or later, otherwise the peak is not reset.
+     */
+    static void resetPeakRSS();
+};
+
+#endif //F2_CMAX_MEMORY_TRACKER_H
@@ -0,0 +1,219 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_PARALLEL_PARTITION_H
+#define F2_CMAX_PARALLEL_PARTITION_H
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "MemoryTracker.h"
+
+/**
+ * In-place partition of a range by a team of threads. The range is cut in one block per thread and each thread
+ * partitions its block. The elements on the wrong side of the final boundary (the elements which do not satisfy the
+ * predicate before it, and the ones which do after it) are then swapped pairwise, the swaps being shared among the
+ * threads. The partition is not stable, as std::partition. The team is created with the object and kept for all its
+ * partitions, the calling thread is the thread 0 of the team.
+ */
+class ParallelPartition {
+    // A range [first, last) of indices of elements on the wrong side of the boundary
+    struct Misplaced {
+        size_t first;
+        size_t last;
+    };
+
+    unsigned int nbThreads;
+    std::vector<std::thread> workers;
+    std::barrier<> phaseBarrier;
+    bool stop = false;
+    // task of the current phase, run by each thread with its index
+    void (*taskFunction)(void *, unsigned int) = nullptr;
+    void *taskContext = nullptr;
+
+    /**
+     * Method that runs a task on each thread of the team and waits for the end of all of them. The task must not throw.
+     */
+    template<class Task>
+    void runOnTeam(Task &task) {
+        taskContext = &task;
+        taskFunction = [](void *context, unsigned int thread) { (*static_cast<Task *>(context))(thread); };
+        phaseBarrier.arrive_and_wait();
+        task(0U);
+        phaseBarrier.arrive_and_wait();
+    }
+
+    /**
+     * Method that swaps the misplaced elements of rank [firstRank, lastRank) of the left side with the ones of the same
+     * rank of the right side.
+     */
+    template<class Iter>
+    static void swapMisplaced(Iter begin, const std::vector<Misplaced> &left, const std::vector<Misplaced> &right, size_t firstRank, size_t lastRank) {
+        if (firstRank >= lastRank) return;
+        // find the range and the offset of the element of rank firstRank on each side
+        auto locate = [firstRank](const std::vector<Misplaced> &ranges, size_t &indexRange, size_t &offset) {
+            size_t rank = firstRank;
+            indexRange = 0;
+            while (rank >= ranges[indexRange].last - ranges[indexRange].first) {
+                rank -= ranges[indexRange].last - ranges[indexRange].first;
+                ++indexRange;
+            }
+            offset = ranges[indexRange].first + rank;
+        };
+        size_t indexLeft, offsetLeft, indexRight, offsetRight;
+        locate(left, indexLeft, offsetLeft);
+        locate(right, indexRight, offsetRight);
+        for (size_t rank = firstRank; rank < lastRank;) {
+            size_t length = std::min({left[indexLeft].last - offsetLeft, right[indexRight].last - offsetRight, lastRank - rank});
+            std::swap_ranges(begin + static_cast<long>(offsetLeft), begin + static_cast<long>(offsetLeft + length), begin + static_cast<long>(offsetRight));
+            rank += length;
+            offsetLeft += length;
+            offsetRight += length;
+            if (offsetLeft == left[indexLeft].last && ++indexLeft < left.size()) offsetLeft = left[indexLeft].first;
+            if (offsetRight == right[indexRight].last && ++indexRight < right.size()) offsetRight = right[indexRight].first;
+        }
+    }
+
+    /**
+     * Method that finds the elements of blocks partitioned separately which are on the wrong side of the boundary.
+     * @param bounds The bounds of the blocks, the block i is [bounds[i], bounds[i+1])
+     * @param nbSatisfying The number of elements at the beginning of each block which satisfy the predicate
+     * @param left The ranges of elements which do not satisfy the predicate, before the boundary
+     * @param right The ranges of elements which satisfy the predicate, after the boundary
+     * @param nbMisplaced The number of elements of each side
+     * @return The boundary, the number of elements which satisfy the predicate
+     */
+    static size_t findMisplaced(const std::vector<size_t> &bounds, const std::vector<size_t> &nbSatisfying,
+                                std::vector<Misplaced> &left, std::vector<Misplaced> &right, size_t &nbMisplaced) {
+        size_t boundary = 0;
+        for (size_t count : nbSatisfying) boundary += count;
+        nbMisplaced = 0;
+        for (size_t block = 0; block < nbSatisfying.size(); ++block) {
+            size_t middle = bounds[block] + nbSatisfying[block];
+            if (middle < std::min(bounds[block + 1], boundary)) {
+                left.push_back({middle, std::min(bounds[block + 1], boundary)});
+                nbMisplaced += left.back().last - left.back().first;
+            }
+            if (std::max(bounds[block], boundary) < middle) right.push_back({std::max(bounds[block], boundary), middle});
+        }
+        return boundary;
+    }
+
+public:
+    static constexpr size_t MIN_SIZE = 1UL << 18; // smaller ranges are partitioned by one thread
+
+    /**
+     * Constructor of the team, its threads wait for the partitions. Their allocations are counted in the memory account
+     * of the calling thread.
+     * @param nbThreads The number of threads, including the calling thread
+     */
+    explicit ParallelPartition(unsigned int nbThreads) : nbThreads(std::max(1U, nbThreads)), phaseBarrier(this->nbThreads) {
+        MemoryTracker::Account &account = MemoryTracker::getAccount();
+        for (unsigned int thread = 1; thread < this->nbThreads; ++thread) {
+            workers.emplace_back([this, thread, &account]() {
+                MemoryTracker::Attach attach(account);
+                while (true) {
+                    phaseBarrier.arrive_and_wait();
+                    if (stop) return;
+                    taskFunction(taskContext, thread);
+                    phaseBarrier.arrive_and_wait();
+                }
+            });
+        }
+    }
+
+    ParallelPartition(const ParallelPartition &) = delete;
+
+    ParallelPartition &operator=(const ParallelPartition &) = delete;
+
+    ~ParallelPartition() {
+        if (workers.empty()) return;
+        stop = true;
+        phaseBarrier.arrive_and_wait();
+        for (auto &worker : workers) worker.join();
+    }
+
+    [[nodiscard]] unsigned int getNbThreads() const { return nbThreads; }
+
+    /**
+     * Method that joins, with the calling thread, consecutive blocks of a range which were partitioned separately: the
+     * elements on the wrong side of the final boundary are swapped pairwise.
+     * @param begin The beginning of the range
+     * @param bounds The bounds of the blocks, the block i is [bounds[i], bounds[i+1])
+     * @param nbSatisfying The number of elements at the beginning of each block which satisfy the predicate
+     * @return The iterator on the first element which does not satisfy the predicate
+     */
+    template<class Iter>
+    static Iter joinBlocks(Iter begin, const std::vector<size_t> &bounds, const std::vector<size_t> &nbSatisfying) {
+        std::vector<Misplaced> left;
+        std::vector<Misplaced> right;
+        size_t nbMisplaced;
+        size_t boundary = findMisplaced(bounds, nbSatisfying, left, right, nbMisplaced);
+        swapMisplaced(begin, left, right, 0, nbMisplaced);
+        return begin + static_cast<long>(boundary);
+    }
+
+    /**
+     * Method that partitions a range: the elements which satisfy the predicate are moved before the others.
+     * @param begin The beginning of the range
+     * @param end The end of the range
+     * @param predicate The predicate, it is called by several threads and must not throw
+     * @return The iterator on the first element which does not satisfy the predicate. The range is partitioned by
+     * std::partition if the team has one thread or if the range has less than MIN_SIZE elements
+     */
+    template<class Iter, class Predicate>
+    Iter partition(Iter begin, Iter end, Predicate predicate) {
+        auto n = static_cast<size_t>(std::distance(begin, end));
+        if (nbThreads <= 1 || n < MIN_SIZE) return std::partition(begin, end, predicate);
+
+        // partition of each block by its thread
+        std::vector<size_t> bounds(nbThreads + 1);
+        for (unsigned int block = 0; block <= nbThreads; ++block) bounds[block] = n * block / nbThreads;
+        std::vector<size_t> nbSatisfying(nbThreads);
+        auto partitionBlock = [&](unsigned int block) {
+            auto blockBegin = begin + static_cast<long>(bounds[block]);
+            nbSatisfying[block] = static_cast<size_t>(std::distance(blockBegin, std::partition(blockBegin, begin + static_cast<long>(bounds[block + 1]), predicate)));
+        };
+        runOnTeam(partitionBlock);
+
+        std::vector<Misplaced> left;
+        std::vector<Misplaced> right;
+        size_t nbMisplaced;
+        size_t boundary = findMisplaced(bounds, nbSatisfying, left, right, nbMisplaced);
+        if (nbMisplaced == 0) return begin + static_cast<long>(boundary);
+
+        // the misplaced elements are swapped by the threads, each one swaps a share of them
+        auto swapShare = [&](unsigned int thread) {
+            swapMisplaced(begin, left, right, nbMisplaced * thread / nbThreads, nbMisplaced * (thread + 1) / nbThreads);
+        };
+        runOnTeam(swapShare);
+        return begin + static_cast<long>(boundary);
+    }
+};
+
+#endif //F2_CMAX_PARALLEL_PARTITION_H
@@ -23,6 +23,7 @@
 
 #ifndef CODE_PARSER_H
 #define CODE_PARSER_H
+#include "FlowShopInstance.h"
 #include "Instance.h"
 #include <string>
 #include "F2CmaxException.h"
@@ -53,12 +54,58 @@ public:
      */
     Instance readFromFile(std::string &filePath) const;
 
+    /**
+     * Method that parses a file into an existing instance, which is reset first. The instance keeps the capacity of its
+     * list of jobs, so that it can be reused without allocation (see InstancePool).
+     * @param filePath The path of the file to parse
+     * @param instance The instance to fill
+     */
+    void readFromFile(std::string &filePath, Instance &instance) const;
+
+    /**
+     * Method that parses an instance from a file descriptor (stdin, pipe, socket...) into an existing instance, which is
+     * reset first. The data is read by large chunks and the file system is never used, so the attributes "name:" and
+     * "n:" are optional: without name, the instance is named after the stream, and without n, the number of jobs is the
+     * number of job lines read. The stream is read until its end, the descriptor is not closed.
+     * @param fileDescriptor The descriptor to read, 0 for stdin
+     * @param instance The instance to fill
+     * @param splitWhileReading If true, each job is added in its set A or B as soon as it is parsed
+     * (see Instance::addJobSplitRevisitedJohnson), so that the split overlaps the reading
+     */
+    void readFromFileDescriptor(int fileDescriptor, Instance &instance, bool splitWhileReading) const;
+
+    /**
+     * Method that parses a file into an existing instance with several threads. The file is mapped in memory, its job
+     * lines are cut in chunks at line boundaries, each thread counts the jobs of one chunk and then parses them in place
+     * in its part of the list of jobs, so no other buffer of jobs is allocated. The attributes must be before the jobs.
+     * @param filePath The path of the file to parse
+     * @param instance The instance to fill
+     * @param nbThreads The number of threads, a chunk has at least 1 MiB so small files use fewer threads
+     * @param splitWhileReading If true, each thread splits its jobs into the sets A and B and sums their processing
+     * times in its part, the parts are then joined and the instance is already split (see Instance::setSplitWhileReading).
+     * Otherwise the jobs keep the order of the file.
+     */
+    void readFromFileParallel(std::string &filePath, Instance &instance, unsigned int nbThreads, bool splitWhileReading) const;
+
     /**
      * Method that serializes an instance into a file specified by the attribute Instance::instancePath.
      * @param instance The instance to be serialized
      */
     void serializeInstance(Instance &instance);
 
+    /**
+     * Method that parses a file of the permutation flow shop, with an attribute "m:" for the number of machines.
+     * @param filePath The path of the file to parse
+     * @return A new flow shop instance constructed from the file
+     */
+    FlowShopInstance readFlowShopFromFile(std::string &filePath) const;
+
+    /**
+     * Method that serializes a flow shop instance into the file FlowShopInstance::instancePath.
+     * @param instance The instance to be serialized
+     */
+    void serializeFlowShopInstance(FlowShopInstance &instance);
+
 
     /**
      * Method that constructs an instance from a JSON object.
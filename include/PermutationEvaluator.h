@@ -0,0 +1,132 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_PERMUTATION_EVALUATOR_H
+#define F2_CMAX_PERMUTATION_EVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "FlowShopInstance.h"
+
+/**
+ * Evaluator of permutations for local search on the permutation flow shop, two machines included. It scores a batch of
+ * candidate sequences of the same jobs LANES at a time: the completion times of the candidates are kept lane by lane and
+ * the (max,+) recurrence is done on all the lanes by SIMD instructions (GCC vector extension, as in BatchSolver).
+ * For the moves of a current sequence, the heads (completion times of the prefixes) and the tails (times from a job to
+ * the end of the schedule) are cached, so that a swap or an insert move between positions i and j is scored in
+ * O(|i-j|m) instead of O(nm).
+ */
+class PermutationEvaluator {
+public:
+    static constexpr size_t LANES = 8; // number of candidates evaluated together
+
+private:
+    const FlowShopInstance *instance = nullptr;
+    size_t nbMachines = 0;
+    std::vector<uint32_t> sequence; // current sequence
+    std::vector<double> heads; // heads[r*m+l]: completion time of the r first jobs of the sequence on machine l
+    std::vector<double> tails; // tails[r*m+l]: time from the start of the job r on machine l to the end
+    std::vector<uint32_t> moveJobs; // jobs of the part of the sequence changed by a move, in their new order
+    std::vector<double> segment; // completion times while a move is scored
+
+    /**
+     * Method that computes the heads of the rows firstRow+1 to n, and the tails of the rows lastRow-1 down to 0.
+     */
+    void updateHeadsAndTails(size_t firstRow, size_t lastRow);
+
+    /**
+     * Makespan of the sequence made of the r first jobs of the current sequence, then moveJobs, then the jobs of the
+     * current sequence from the position after, in O((|moveJobs| + 1)m).
+     */
+    double evaluateMoveJobs(size_t r, size_t after);
+
+    /**
+     * Method that fills moveJobs with the new order of the positions min(i,j) to max(i,j) after a move.
+     * @return The positions (r, after) of evaluateMoveJobs
+     */
+    std::pair<size_t,size_t> buildSwap(size_t first, size_t second);
+    std::pair<size_t,size_t> buildInsert(size_t from, size_t to);
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    explicit PermutationEvaluator(const FlowShopInstance *instance);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that computes the makespan of a batch of sequences of all the jobs of the instance.
+     * @param sequences The sequences one after the other, sequence c is sequences[c*n] to sequences[c*n+n-1]
+     * @param nbSequences The number of sequences
+     * @param cmax The array of nbSequences makespans to fill
+     */
+    void evaluateBatch(const uint32_t *sequences, size_t nbSequences, double *cmax) const;
+
+    /**
+     * Method that sets the current sequence of the moves and caches its heads and tails in O(nm).
+     * @param newSequence The indices of the jobs in the order of the sequence
+     * @return The makespan of the sequence
+     */
+    double setSequence(std::span<const uint32_t> newSequence);
+
+    /**
+     * Method that computes the makespan of the current sequence after exchanging the jobs at two positions.
+     */
+    double evaluateSwap(size_t first, size_t second);
+
+    /**
+     * Method that computes the makespan of the current sequence after moving the job at position from so that it is at
+     * position to, the jobs between are shifted by one position.
+     */
+    double evaluateInsert(size_t from, size_t to);
+
+    /**
+     * Method that applies a swap move to the current sequence and updates the cache.
+     * @return The makespan of the new current sequence
+     */
+    double applySwap(size_t first, size_t second);
+
+    /**
+     * Method that applies an insert move to the current sequence and updates the cache.
+     * @return The makespan of the new current sequence
+     */
+    double applyInsert(size_t from, size_t to);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] const std::vector<uint32_t> &getSequence() const { return sequence; }
+
+    [[nodiscard]] double getCmax() const { return heads.empty() ? 0.0 : heads[sequence.size() * nbMachines + nbMachines - 1]; }
+};
+
+#endif //F2_CMAX_PERMUTATION_EVALUATOR_H
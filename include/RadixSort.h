@@ -34,7 +34,14 @@
 #include <utility>
 #include <numeric>
 #include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+#include "JobAllocator.h"
+#include <iterator>
 
 /* PROPERTIES:
 ** - Inplace
@@ -377,111 +384,362 @@ namespace RadixSortByFirstDetails
 
         return reinterpret_cast<const byte*>(&num);
     }
+
+    /// Sorts the n pairs of data by their first member with the buffer tmp of n pairs, and returns the buffer holding the result.
+    template<class Pair>
+    Pair* radixsort_by_first_passes(Pair* data, Pair* tmp, std::size_t n)
+    {
+        using Key = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<Pair>().first)>>;
+
+        static_assert(std::is_arithmetic_v<Key>,
+            "Pair::first must be an arithmetic type.");
+        static_assert(sizeof(Key) <= 8,
+            "This implementation is intended for up to 64-bit keys.");
+
+        constexpr std::size_t HISTOGRAM_SIZE = 256;
+        constexpr std::size_t HISTOGRAM_HALF = 128;
+        constexpr std::size_t KEY_BYTES = sizeof(Key);
+
+        std::array<std::array<std::size_t, HISTOGRAM_SIZE>, KEY_BYTES> histograms{};
+        std::array<std::size_t, KEY_BYTES> max_counts{};
+
+        bool sorted = true;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (i > 0 && data[i - 1].first > data[i].first)
+                sorted = false;
+
+            const byte* positions = ubyte(data[i].first);
+            for (std::size_t b = 0; b < KEY_BYTES; ++b)
+            {
+                const std::size_t c = ++histograms[b][positions[b]];
+                if (c > max_counts[b]) max_counts[b] = c;
+            }
+        }
+
+        if (sorted) return data;
+
+        constexpr std::size_t SKIP_ROUND = std::numeric_limits<std::size_t>::max();
+        for (std::size_t b = 0; b < KEY_BYTES; ++b)
+        {
+            if (max_counts[b] == n)
+                histograms[b][0] = SKIP_ROUND;
+        }
+
+        const auto& last = histograms[KEY_BYTES - 1];
+        const std::size_t negatives =
+            lim<Key>::is_signed
+                ? std::accumulate(last.begin() + HISTOGRAM_HALF, last.end(), std::size_t{0})
+                : 0;
+
+        Pair* src = data;
+        Pair* dst = tmp;
+
+        std::array<std::size_t, HISTOGRAM_SIZE> offsets{};
+
+        for (std::size_t shift_bytes = 0; shift_bytes < KEY_BYTES; ++shift_bytes)
+        {
+            const auto& hist = histograms[shift_bytes];
+            if (hist[0] == SKIP_ROUND) continue;
+
+            const bool last_round = (shift_bytes == KEY_BYTES - 1);
+            const bool special = last_round && lim<Key>::is_signed;
+
+            offsets[0] = special ? negatives : 0;
+
+            std::size_t i = 1;
+            for (; i < HISTOGRAM_HALF; ++i)
+                offsets[i] = offsets[i - 1] + hist[i - 1];
+
+            if (special && lim<Key>::is_iec559)
+            {
+                offsets[HISTOGRAM_SIZE - 1] = 0;
+                for (int j = static_cast<int>(HISTOGRAM_SIZE) - 2; j >= static_cast<int>(HISTOGRAM_HALF); --j)
+                    offsets[j] = offsets[j + 1] + hist[j + 1];
+
+                for (std::size_t j = HISTOGRAM_HALF; j < HISTOGRAM_SIZE; ++j)
+                    offsets[j] += hist[j];
+            }
+            else
+            {
+                if (special)
+                    offsets[i++] = 0;
+
+                for (; i < HISTOGRAM_SIZE; ++i)
+                    offsets[i] = offsets[i - 1] + hist[i - 1];
+            }
+
+            for (std::size_t indexElem = 0; indexElem < n; ++indexElem)
+            {
+                const auto& elem = src[indexElem];
+                const byte radix = ubyte(elem.first)[shift_bytes];
+
+                if (special && lim<Key>::is_iec559 && radix >= HISTOGRAM_HALF)
+                    dst[--offsets[radix]] = elem;
+                else
+                    dst[offsets[radix]++] = elem;
+            }
+
+            std::swap(src, dst);
+        }
+
+        return src;
+    }
 }
 
 template<class Pair>
 void radixsort_by_first(std::vector<Pair>& v)
 {
-    using namespace RadixSortByFirstDetails;
-
-    using Key = std::remove_cv_t<std::remove_reference_t<decltype(std::declval<Pair>().first)>>;
+    const std::size_t n = v.size();
+    if (n < 2) return;
 
-    static_assert(std::is_arithmetic_v<Key>,
-        "Pair::first must be an arithmetic type.");
-    static_assert(sizeof(Key) <= 8,
-        "This implementation is intended for up to 64-bit keys.");
+    std::vector<Pair> tmp(n);
+    if (RadixSortByFirstDetails::radixsort_by_first_passes(v.data(), tmp.data(), n) != v.data())
+        v = std::move(tmp);
+}
 
-    constexpr std::size_t HISTOGRAM_SIZE = 256;
-    constexpr std::size_t HISTOGRAM_HALF = 128;
-    constexpr std::size_t KEY_BYTES = sizeof(Key);
+/// Radix sort by first member of a contiguous range of pairs, e.g. a prefix of a vector.
+template<class Iter>
+void radixsort_by_first(Iter begin, Iter end)
+{
+    using Pair = typename std::iterator_traits<Iter>::value_type;
 
-    const std::size_t n = v.size();
+    const auto n = static_cast<std::size_t>(std::distance(begin, end));
     if (n < 2) return;
 
-    std::array<std::array<std::size_t, HISTOGRAM_SIZE>, KEY_BYTES> histograms{};
-    std::array<std::size_t, KEY_BYTES> max_counts{};
-
-    bool sorted = true;
+    // scratch buffer allocated with the policy of the job arrays (huge pages, NUMA placement)
+    std::vector<Pair, JobAllocator<Pair>> tmp(n);
+    Pair* data = &*begin;
+    if (RadixSortByFirstDetails::radixsort_by_first_passes(data, tmp.data(), n) != data)
+        std::copy(tmp.begin(), tmp.end(), data);
+}
 
-    for (std::size_t i = 0; i < n; ++i)
+namespace RadixSortByFirstDetails
+{
+    /// Bits of a key, to find the bytes which are not the same for all keys.
+    template<class Key>
+    std::uint64_t key_bits(const Key& key)
     {
-        if (i > 0 && v[i - 1].first > v[i].first)
-            sorted = false;
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &key, sizeof(Key));
+        return bits;
+    }
 
-        const byte* positions = ubyte(v[i].first);
-        for (std::size_t b = 0; b < KEY_BYTES; ++b)
+    /// End of the run by first member which starts at index start: a maximal non-decreasing or non-increasing run.
+    /// varying gets the bits which differ between consecutive keys of the run.
+    template<class Iter>
+    std::size_t run_end_by_first(Iter begin, std::size_t start, std::size_t n, std::uint64_t& varying)
+    {
+        auto compare = [begin, &varying](std::size_t i) { varying |= key_bits(begin[i].first) ^ key_bits(begin[i - 1].first); };
+        std::size_t stop = start + 1;
+        while (stop < n && begin[stop].first == begin[stop - 1].first)
+            compare(stop++);
+        if (stop < n && begin[stop].first < begin[stop - 1].first)
+        {
+            while (stop < n && !(begin[stop - 1].first < begin[stop].first))
+                compare(stop++);
+        }
+        else
         {
-            const std::size_t c = ++histograms[b][positions[b]];
-            if (c > max_counts[b]) max_counts[b] = c;
+            while (stop < n && !(begin[stop].first < begin[stop - 1].first))
+                compare(stop++);
         }
+        return stop;
     }
+}
 
-    if (sorted) return;
+/// Boundaries of the runs by first member of a contiguous range of pairs, i.e. its maximal non-decreasing or
+/// non-increasing parts, found in one scan. runs gets the index of the start of the max_stored first runs, and n if all
+/// runs are stored. Returns the number of runs, 1 if the range is sorted. varying_bytes gets the number of bytes of the
+/// keys which are not the same for all pairs, which is the number of passes of radixsort_by_first on the range.
+template<class Iter>
+std::size_t find_runs_by_first(Iter begin, Iter end, std::vector<std::size_t>& runs, std::size_t max_stored, std::size_t& varying_bytes)
+{
+    using Key = std::remove_cv_t<decltype(begin->first)>;
 
-    constexpr std::size_t SKIP_ROUND = std::numeric_limits<std::size_t>::max();
-    for (std::size_t b = 0; b < KEY_BYTES; ++b)
+    const auto n = static_cast<std::size_t>(std::distance(begin, end));
+    runs.clear();
+    std::size_t nb_runs = 0;
+    std::uint64_t varying = 0;
+    for (std::size_t start = 0; start < n; start = RadixSortByFirstDetails::run_end_by_first(begin, start, n, varying))
     {
-        if (max_counts[b] == n)
-            histograms[b][0] = SKIP_ROUND;
+        if (start > 0)
+            varying |= RadixSortByFirstDetails::key_bits(begin[start].first) ^ RadixSortByFirstDetails::key_bits(begin[start - 1].first);
+        if (nb_runs++ < max_stored)
+            runs.push_back(start);
     }
+    if (nb_runs <= max_stored)
+        runs.push_back(n);
+    varying_bytes = 0;
+    for (std::size_t b = 0; b < sizeof(Key); ++b)
+        varying_bytes += ((varying >> (8 * b)) & 0xFF) != 0;
+    return nb_runs;
+}
 
-    const auto& last = histograms[KEY_BYTES - 1];
-    const std::size_t negatives =
-        lim<Key>::is_signed
-            ? std::accumulate(last.begin() + HISTOGRAM_HALF, last.end(), std::size_t{0})
-            : 0;
+/// Number of runs by first member of a contiguous range of pairs, as found by find_runs_by_first. It measures how
+/// presorted the range is: 1 if it is sorted (or sorted in reverse), about n/3 if it is in a random order.
+template<class Iter>
+std::size_t count_runs_by_first(Iter begin, Iter end)
+{
+    std::vector<std::size_t> runs;
+    std::size_t varying_bytes;
+    return find_runs_by_first(begin, end, runs, 0, varying_bytes);
+}
 
-    std::vector<Pair> tmp(n);
-    auto* src = &v;
-    auto* dst = &tmp;
+/// Adaptive sort by first member of a contiguous range of pairs. The runs are found in one scan, with the number of
+/// passes of the radix sort (the bytes of the keys which are not the same for all pairs). Merging the runs pairwise
+/// moves the pairs ceil(log2(runs)) times, the radix sort reads them once for its histograms and moves them once per
+/// pass: if the merge does not move them more often (the range is presorted with a few perturbations), the
+/// non-increasing runs are reversed and merged, otherwise the range is sorted by radixsort_by_first. Unlike the radix
+/// sort, the merge of runs is not stable since the equal keys of a reversed run are reversed too.
+/// Returns the number of runs of the range before the sort.
+template<class Iter>
+std::size_t adaptivesort_by_first(Iter begin, Iter end)
+{
+    using Pair = typename std::iterator_traits<Iter>::value_type;
 
-    std::array<std::size_t, HISTOGRAM_SIZE> offsets{};
+    const auto n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n < 2) return n;
 
-    for (std::size_t shift_bytes = 0; shift_bytes < KEY_BYTES; ++shift_bytes)
+    // at most 8 passes of the radix sort, so at most 2^8 runs are merged
+    constexpr std::size_t MAX_MERGED_RUNS = std::size_t{1} << sizeof(Pair::first);
+    std::vector<std::size_t> runs;
+    std::size_t nb_passes;
+    const std::size_t nb_runs = find_runs_by_first(begin, end, runs, MAX_MERGED_RUNS, nb_passes);
+    if (nb_runs > MAX_MERGED_RUNS || static_cast<std::size_t>(std::bit_width(nb_runs - 1)) > nb_passes)
     {
-        const auto& hist = histograms[shift_bytes];
-        if (hist[0] == SKIP_ROUND) continue;
+        radixsort_by_first(begin, end);
+        return nb_runs;
+    }
 
-        const bool last_round = (shift_bytes == KEY_BYTES - 1);
-        const bool special = last_round && lim<Key>::is_signed;
+    Pair* data = &*begin;
+    for (std::size_t run = 0; run + 1 < runs.size(); ++run)
+    {
+        if (data[runs[run + 1] - 1].first < data[runs[run]].first)
+            std::reverse(data + runs[run], data + runs[run + 1]);
+    }
+    if (nb_runs == 1) return nb_runs;
+
+    // bottom-up merge of the runs, from the range to the buffer and back
+    std::vector<Pair, JobAllocator<Pair>> tmp(n);
+    Pair* src = data;
+    Pair* dst = tmp.data();
+    auto by_first = [](const Pair& left, const Pair& right) { return left.first < right.first; };
+    while (runs.size() > 2)
+    {
+        std::size_t nb_merged = 0;
+        std::size_t run = 0;
+        for (; run + 2 < runs.size(); run += 2)
+        {
+            std::merge(src + runs[run], src + runs[run + 1], src + runs[run + 1], src + runs[run + 2], dst + runs[run], by_first);
+            runs[nb_merged++] = runs[run];
+        }
+        if (run + 1 < runs.size())
+        {
+            std::copy(src + runs[run], src + runs[run + 1], dst + runs[run]);
+            runs[nb_merged++] = runs[run];
+        }
+        runs[nb_merged++] = n;
+        runs.resize(nb_merged);
+        std::swap(src, dst);
+    }
+    if (src != data)
+        std::copy(src, src + n, data);
+    return nb_runs;
+}
 
-        offsets[0] = special ? negatives : 0;
+/// Counting sort by first member of a contiguous range of pairs whose keys are integers in [0, max_key].
+/// Returns false, without modifying the range nor allocating, if a key is not an integer in [0, max_key]. The keys are
+/// checked before the counters are allocated, for the largest key of the range only.
+template<class Iter>
+bool countingsort_by_first(Iter begin, Iter end, std::size_t max_key)
+{
+    using Pair = typename std::iterator_traits<Iter>::value_type;
 
-        std::size_t i = 1;
-        for (; i < HISTOGRAM_HALF; ++i)
-            offsets[i] = offsets[i - 1] + hist[i - 1];
+    const auto n = static_cast<std::size_t>(std::distance(begin, end));
+    if (n < 2) return true;
 
-        if (special && lim<Key>::is_iec559)
-        {
-            offsets[HISTOGRAM_SIZE - 1] = 0;
-            for (int j = static_cast<int>(HISTOGRAM_SIZE) - 2; j >= static_cast<int>(HISTOGRAM_HALF); --j)
-                offsets[j] = offsets[j + 1] + hist[j + 1];
+    double largest_key = 0.0;
+    for (auto it = begin; it != end; ++it)
+    {
+        const auto key = it->first;
+        if (!(key >= 0) || key > static_cast<double>(max_key) || key != std::floor(key))
+            return false;
+        largest_key = std::max<double>(largest_key, key);
+    }
+    std::vector<std::size_t> offsets(static_cast<std::size_t>(largest_key) + 2, 0);
+    for (auto it = begin; it != end; ++it)
+        ++offsets[static_cast<std::size_t>(it->first) + 1];
+    for (std::size_t key = 1; key < offsets.size(); ++key)
+        offsets[key] += offsets[key - 1];
+
+    std::vector<Pair, JobAllocator<Pair>> tmp(n);
+    for (auto it = begin; it != end; ++it)
+        tmp[offsets[static_cast<std::size_t>(it->first)]++] = *it;
+    std::copy(tmp.begin(), tmp.end(), begin);
+    return true;
+}
 
-            for (std::size_t j = HISTOGRAM_HALF; j < HISTOGRAM_SIZE; ++j)
-                offsets[j] += hist[j];
-        }
-        else
-        {
-            if (special)
-                offsets[i++] = 0;
+#pragma pack(push, 4)
+/// Compact record of a key and the index of its element, sorted instead of the elements themselves (12 bytes).
+struct RadixKeyIndex
+{
+    std::uint64_t key;
+    std::uint32_t index;
+};
+#pragma pack(pop)
 
-            for (; i < HISTOGRAM_SIZE; ++i)
-                offsets[i] = offsets[i - 1] + hist[i - 1];
-        }
+/// Maps an IEEE-754 double to an unsigned integer with the same order, so that keys are sorted as unsigned integers.
+inline std::uint64_t radix_ordered_key(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t{1} << 63);
+}
 
-        for (const auto& elem : *src)
-        {
-            const byte radix = ubyte(elem.first)[shift_bytes];
+/// LSB radix sort of n records by increasing key. Only the records move, the elements they index stay in place.
+/// As for radixsort_by_first, a sorted input is detected and rounds where all keys share the byte are skipped.
+inline void radixsort_key_index(RadixKeyIndex* data, std::size_t n)
+{
+    constexpr std::size_t HISTOGRAM_SIZE = 256;
+    constexpr std::size_t KEY_BYTES = sizeof(std::uint64_t);
 
-            if (special && lim<Key>::is_iec559 && radix >= HISTOGRAM_HALF)
-                (*dst)[--offsets[radix]] = elem;
-            else
-                (*dst)[offsets[radix]++] = elem;
-        }
+    if (n < 2) return;
+
+    std::array<std::array<std::size_t, HISTOGRAM_SIZE>, KEY_BYTES> histograms{};
+    bool sorted = true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const std::uint64_t key = data[i].key;
+        if (i > 0 && data[i - 1].key > key)
+            sorted = false;
+        for (std::size_t b = 0; b < KEY_BYTES; ++b)
+            ++histograms[b][(key >> (8 * b)) & 0xFF];
+    }
+    if (sorted) return;
+
+    std::vector<RadixKeyIndex, JobAllocator<RadixKeyIndex>> tmp(n);
+    RadixKeyIndex* src = data;
+    RadixKeyIndex* dst = tmp.data();
+    std::array<std::size_t, HISTOGRAM_SIZE> offsets{};
+
+    for (std::size_t shift_bytes = 0; shift_bytes < KEY_BYTES; ++shift_bytes)
+    {
+        const auto& hist = histograms[shift_bytes];
+        // skip the round if all keys have the same byte
+        if (hist[(src[0].key >> (8 * shift_bytes)) & 0xFF] == n) continue;
+
+        offsets[0] = 0;
+        for (std::size_t i = 1; i < HISTOGRAM_SIZE; ++i)
+            offsets[i] = offsets[i - 1] + hist[i - 1];
+
+        for (std::size_t indexElem = 0; indexElem < n; ++indexElem)
+            dst[offsets[(src[indexElem].key >> (8 * shift_bytes)) & 0xFF]++] = src[indexElem];
 
         std::swap(src, dst);
     }
 
-    if (src != &v)
-        v = std::move(*src);
-}
\ No newline at end of file
+    if (src != data)
+        std::copy(src, src + n, data);
+}
@@ -0,0 +1,134 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_RESULT_CACHE_H
+#define F2_CMAX_RESULT_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+#include "CostModel.h"
+
+/**
+ * Persistent cache of the results of the in-memory solver, so that a config run again does not solve the instances which
+ * did not change. A result is keyed by a hash of the content of the instance file and by the parameters of the method
+ * (engine, useRevisited, prefixSort). The cache is a JSON file, read when the cache is constructed and written by save.
+ */
+class ResultCache {
+public:
+    // The result of one instance solved by one method, the times are not kept
+    struct Result {
+        std::string instanceName;
+        unsigned int nbJobs = 0;
+        double supPj = 0.0;
+        ENGINE engine = ALL; // the engine which solved the instance, the selected one with "auto"
+        std::array<size_t,6> metrics{}; // PptA, K_a, K_a_p, PptB, K_b, K_b_p
+        std::array<size_t,2> runs{}; // RunsA, RunsB
+        double objective = 0.0;
+    };
+
+private:
+    std::filesystem::path cachePath;
+    std::unordered_map<std::string, Result> results;
+    bool modified = false;
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor that reads the cache file, if it exists.
+     * @param cachePath The path of the cache file
+     */
+    explicit ResultCache(const std::filesystem::path &cachePath);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that hashes the content of a file, 32 bytes at a time on four independent lanes. The hash is not a
+     * cryptographic one, it only detects the files which changed.
+     * @param filePath The path of the file
+     * @return The hash of the file
+     */
+    static uint64_t hashFile(const std::string &filePath);
+
+    /**
+     * Method that builds the key of a result.
+     * @param contentHash The hash of the instance file
+     * @param engine The engine of the method
+     * @param useRevisited The parameter useRevisited of the method
+     * @param prefixSort The name of the prefix sort of the method
+     * @return The key of the result
+     */
+    static std::string getKey(uint64_t contentHash, ENGINE engine, bool useRevisited, const std::string &prefixSort);
+
+    /**
+     * Method that finds a result.
+     * @param key The key of the result
+     * @return The result, or nullptr if it is not in the cache
+     */
+    [[nodiscard]] const Result *find(const std::string &key) const;
+
+    /**
+     * Method that adds or replaces a result.
+     * @param key The key of the result
+     * @param result The result
+     */
+    void insert(const std::string &key, const Result &result);
+
+    /**
+     * Method that writes the cache file, if a result was added.
+     */
+    void save();
+
+    /**
+     * Method that writes a cached result in the results file of the in-memory solver, with null times.
+     * @param result The cached result
+     * @param instancePath The path of the instance file
+     * @param useRevisited If true, the columns of the revisited algorithm are written
+     * @param fileOutputName The path of the results file
+     */
+    static void printOutput(const Result &result, const std::string &instancePath, bool useRevisited, const std::string &fileOutputName);
+
+    /**
+     * Method that writes a cached result as one line of the results file, without its header.
+     * @see ResultCache::printOutput
+     * @param outputFile The stream of the results file
+     */
+    static void printRow(const Result &result, const std::string &instancePath, bool useRevisited, std::ostream &outputFile);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] size_t getNbResults() const { return results.size(); }
+};
+
+#endif //F2_CMAX_RESULT_CACHE_H
@@ -0,0 +1,127 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_SCALING_SWEEP_H
+#define F2_CMAX_SCALING_SWEEP_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "CostModel.h"
+
+/**
+ * Scaling sweep of the engines on generated instances. For each distribution, maximum processing time and number of jobs,
+ * instances are generated and solved by each engine, the median time of the repetitions is kept. The empirical
+ * complexity of each engine is fitted on the times of its sweep, and the times are compared to a baseline file recorded
+ * on the same machine, so that a regression of an engine is flagged.
+ */
+class ScalingSweep {
+public:
+    // The median time of an engine on the instances of a configuration of the sweep
+    struct Point {
+        ENGINE engine = STL;
+        std::string distribution;
+        unsigned int pmax = 0;
+        unsigned int n = 0;
+        double time = 0.0; // time of the engine, as in the results of the solver
+        double timeSolve = 0.0; // time of the whole solve, including the split and the metrics
+        double baselineTime = 0.0; // 0 if the point is not in the baseline
+        bool regression = false;
+    };
+
+    // The empirical complexity of an engine on one distribution and one maximum processing time
+    struct Fit {
+        double exponent = 0.0; // slope of log(time) over log(n)
+        double coefN = 0.0; // median of time / n
+        double spreadN = 0.0; // coefficient of variation of time / n
+        double coefNLogN = 0.0; // median of time / (n log2 n)
+        double spreadNLogN = 0.0; // coefficient of variation of time / (n log2 n)
+    };
+
+private:
+    unsigned int seed = 0;
+    unsigned int repetitions = 3;
+    std::vector<unsigned int> listN{1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    std::vector<unsigned int> listPMax{100, 10000};
+    std::vector<std::string> listDistributions{"uniform", "negative_binomial", "geometric", "poisson", "exponential", "gamma", "weibull", "lognormal"};
+    std::vector<ENGINE> engines{STL, RADIX, REVISITED};
+    size_t memoryLimit = 0; // in bytes, the numbers of jobs which need more memory are skipped
+    std::filesystem::path outputDir;
+    std::filesystem::path baselinePath; // if empty, the times are not compared
+    bool updateBaseline = false;
+    double tolerance = 0.25; // relative slowdown allowed before a regression is flagged
+    double minTime = 1E-4; // in seconds, shorter times are too noisy to be compared
+    std::vector<Point> points;
+
+    /**
+     * Method that compares the points to the baseline file and flags the regressions.
+     * @return The number of regressions
+     */
+    size_t compareToBaseline();
+
+    void saveBaseline() const;
+
+    void printOutput() const;
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor that reads the parameters of the sweep. The JSON object may contain the attributes "output", "seed",
+     * "repetitions", "n", "pmax", "distributions", "engines", "memoryLimit", "baseline", "updateBaseline", "tolerance"
+     * and "minTime", see README file.
+     * @param paramSweep The JSON object of parameters
+     */
+    explicit ScalingSweep(const nlohmann::json &paramSweep);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that runs the sweep, writes its results and compares them to the baseline. An exception is thrown after the
+     * results are written if a regression is found.
+     */
+    void run();
+
+    /**
+     * Method that fits the empirical complexity of a list of times.
+     * @param samples The samples (n, time), sorted by n
+     * @return The fit of the samples
+     */
+    static Fit fitComplexity(const std::vector<std::pair<double,double>> &samples);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] const std::vector<Point> &getPoints() const { return points; }
+};
+
+#endif //F2_CMAX_SCALING_SWEEP_H
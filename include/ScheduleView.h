@@ -0,0 +1,179 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_SCHEDULE_VIEW_H
+#define F2_CMAX_SCHEDULE_VIEW_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <span>
+
+#include "Instance.h"
+
+/**
+ * Lazy view of Johnson's schedule of an instance: the jobs of A in increasing order of p1, then the jobs of B in
+ * decreasing order of p2, as walked by Solver::evaluate. It does not copy the jobs, it reads them through a permutation
+ * of the list of jobs in the order of the instance file, so that each job is given with its original id (its index in
+ * the file). The start and completion times on both machines are computed while the view is walked.
+ */
+class ScheduleView {
+public:
+    // One job of the schedule
+    struct ScheduledJob {
+        uint32_t jobId; // index of the job in the instance file
+        double startM1;
+        double completionM1;
+        double startM2;
+        double completionM2;
+    };
+
+    /**
+     * Writer of the lines of a schedule, one line per job with its id and its start and completion times on both
+     * machines. The lines are formatted in a buffer with std::to_chars (shortest exact representation of the times) and
+     * written by blocks, so that a schedule of many jobs is streamed without building it. The buffer is written when the
+     * writer is destroyed.
+     */
+    class Writer {
+        static constexpr size_t BUFFER_SIZE = 1UL << 16;
+        static constexpr size_t MAX_LINE_SIZE = 128; // an id and four doubles of at most 24 characters each, with the separators
+        std::ostream &outputStream;
+        char buffer[BUFFER_SIZE];
+        size_t size = 0;
+
+    public:
+        explicit Writer(std::ostream &outputStream) : outputStream(outputStream) {
+            outputStream << "JobId\tStartM1\tCompletionM1\tStartM2\tCompletionM2\n";
+        }
+
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        ~Writer() { flush(); }
+
+        void add(uint64_t jobId, double startM1, double completionM1, double startM2, double completionM2) {
+            if (size + MAX_LINE_SIZE > BUFFER_SIZE) flush();
+            char *it = std::to_chars(buffer + size, buffer + BUFFER_SIZE, jobId).ptr;
+            for (double time : {startM1, completionM1, startM2, completionM2}) {
+                *it++ = '\t';
+                it = std::to_chars(it, buffer + BUFFER_SIZE, time).ptr;
+            }
+            *it++ = '\n';
+            size = static_cast<size_t>(it - buffer);
+        }
+
+        void flush() {
+            outputStream.write(buffer, static_cast<std::streamsize>(size));
+            size = 0;
+        }
+    };
+
+    /**
+     * Iterator over the schedule, it keeps the completion times of the previous job on both machines.
+     */
+    class Iterator {
+        const Instance::Job *jobs = nullptr;
+        const uint32_t *position = nullptr;
+        double timeM1 = 0.0;
+        double timeM2 = 0.0;
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type = ScheduledJob;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        Iterator(const Instance::Job *jobs, const uint32_t *position) : jobs(jobs), position(position) {}
+
+        ScheduledJob operator*() const {
+            auto &[pi1,pi2] = jobs[*position];
+            double completionM1 = timeM1 + pi1;
+            double startM2 = std::max(completionM1, timeM2);
+            return {*position, timeM1, completionM1, startM2, startM2 + pi2};
+        }
+
+        Iterator &operator++() {
+            auto &[pi1,pi2] = jobs[*position++];
+            timeM1 += pi1;
+            timeM2 = std::max(timeM1, timeM2) + pi2;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const { return position == other.position; }
+    };
+
+private:
+    std::span<const Instance::Job> jobs; // in the order of the instance file
+    std::span<const uint32_t> order; // Johnson's order, as indices in jobs
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the view, the jobs and the order must outlive it.
+     * @param jobs The jobs in the order of the instance file
+     * @param order Johnson's order as indices in jobs (see Solver::computeJohnsonOrder)
+     */
+    ScheduleView(std::span<const Instance::Job> jobs, std::span<const uint32_t> order) : jobs(jobs), order(order) {}
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    [[nodiscard]] Iterator begin() const { return {jobs.data(), order.data()}; }
+
+    [[nodiscard]] Iterator end() const { return {jobs.data(), order.data() + order.size()}; }
+
+    [[nodiscard]] size_t size() const { return order.size(); }
+
+    /**
+     * Method that writes the schedule with a Writer.
+     * @param outputStream The stream
+     * @return The makespan of the schedule
+     */
+    double write(std::ostream &outputStream) const {
+        Writer writer(outputStream);
+        double makespan = 0.0;
+        for (const ScheduledJob &job : *this) {
+            writer.add(job.jobId, job.startM1, job.completionM1, job.startM2, job.completionM2);
+            makespan = job.completionM2;
+        }
+        return makespan;
+    }
+};
+
+#endif //F2_CMAX_SCHEDULE_VIEW_H
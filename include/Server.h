@@ -0,0 +1,115 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_SERVER_H
+#define F2_CMAX_SERVER_H
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Instance.h"
+#include "Parser.h"
+#include "Solver.h"
+
+/**
+ * Long-running server answering solve requests, one JSON object per line, on stdin/stdout or on a Unix domain socket.
+ * A request gives the jobs inline or the path of an instance file:
+ *      {"id": <any>, "jobs": [[p11,p12],[p21,p22],...], "permutation": <bool>}
+ *      {"id": <any>, "path": "<string>"}
+ *      {"command": "shutdown"}
+ * and the answer is {"id": <any>, "cmax": <double>} with the "permutation" of the jobs (indices from 0 in the order of
+ * the request or of the file) if it is asked, or {"id": <any>, "error": "<string>"}. Without permutation the instance is
+ * solved by the engine CMAX_ONLY, otherwise by the engine PERMUTATION. Each worker thread keeps its instance and its
+ * solver between requests, so their buffers are already allocated for the next request.
+ */
+class Server {
+public:
+    // Buffers of a worker kept between requests
+    struct Worker {
+        Instance instance;
+        Solver solver{&instance, true};
+        Parser parser;
+    };
+
+private:
+    unsigned int nbThreads = 1;
+    std::atomic<bool> stopRequested{false};
+    int listenSocket = -1;
+    std::mutex connectionsMutex;
+    std::vector<int> connections; // the connections being served, their reading side is shut down by a shutdown request
+
+    /**
+     * Method that serves a connected socket until it is closed or the server is stopped.
+     */
+    void serveConnection(int connection, Worker &worker);
+
+    /**
+     * Method that shuts down the reading side of the connections being served, so that their workers stop at their next
+     * read even if their clients keep them open.
+     */
+    void stopConnections();
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the server.
+     * @param nbThreads The number of connections served in parallel on a socket
+     */
+    explicit Server(unsigned int nbThreads = 1);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that answers a request.
+     * @param request The request, one JSON object
+     * @param worker The buffers used to solve the instance
+     * @return The answer, one JSON object without end of line
+     */
+    std::string handleRequest(const std::string &request, Worker &worker);
+
+    /**
+     * Method that serves the requests of a stream (for instance stdin) until its end or a shutdown request.
+     */
+    void serveStream(std::istream &input, std::ostream &output);
+
+    /**
+     * Method that serves the requests of the connections to a Unix domain socket until a shutdown request. Each worker
+     * thread accepts a connection and serves it until it is closed or until a shutdown request.
+     * @param socketPath The path of the socket, an existing file is replaced
+     */
+    void serveSocket(const std::string &socketPath);
+
+    [[nodiscard]] bool isStopped() const { return stopRequested.load(); }
+};
+
+#endif //F2_CMAX_SERVER_H
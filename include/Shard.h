@@ -0,0 +1,112 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_SHARD_H
+#define F2_CMAX_SHARD_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Shard i of N of a solve campaign, so that several processes, on one machine or on several, run the same configs and
+ * each one solves a part of the instance files. An instance file belongs to the shard of the hash of its normalized path
+ * modulo N, so every method of a file is run by the same shard and the partition is the same on every machine. Each shard
+ * writes its own results files, suffixed by "_shard<i>of<N>", which Shard::merge combines.
+ */
+class Shard {
+    unsigned int index = 0;
+    unsigned int count = 1;
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the single shard, which contains every instance file.
+     */
+    Shard() = default;
+
+    /**
+     * Constructor of a shard.
+     * @param index The index of the shard, from 0 to count-1
+     * @param count The number of shards, at least 1
+     */
+    Shard(unsigned int index, unsigned int count);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that reads a shard written "i/N".
+     * @param shardText The shard
+     * @return The shard
+     */
+    static Shard parse(const std::string &shardText);
+
+    /**
+     * Method that hashes the normalized path of an instance file with FNV-1a, which does not depend on the compiler or on
+     * the machine as std::hash does.
+     * @param path The path of the instance file
+     * @return The hash of the path
+     */
+    static uint64_t hashPath(const std::string &path);
+
+    /**
+     * Method that tells if an instance file belongs to the shard.
+     * @param path The path of the instance file
+     */
+    [[nodiscard]] bool contains(const std::string &path) const { return count == 1 || hashPath(path) % count == index; }
+
+    /**
+     * Method that gives the path of the file written by the shard in place of a file, "results.csv" becomes
+     * "results_shard<i>of<N>.csv". The path is not changed for the single shard.
+     * @param filePath The path of the file
+     */
+    [[nodiscard]] std::string getPath(const std::string &filePath) const;
+
+    /**
+     * Method that merges the results files written by the shards of a campaign in a directory into the results files of
+     * an unsharded run. The rows of the results files are sorted by instance path, the rows of an instance staying in
+     * the order of the methods, so that the result set does not depend on the number of shards. The summaries are
+     * combined group by group. The merged files replace the existing ones.
+     * @param outputDir The directory of the results files
+     * @param count The number of shards
+     */
+    static void merge(const std::string &outputDir, unsigned int count);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] unsigned int getIndex() const { return index; }
+
+    [[nodiscard]] unsigned int getCount() const { return count; }
+
+    [[nodiscard]] bool isSharded() const { return count > 1; }
+};
+
+#endif //F2_CMAX_SHARD_H
@@ -0,0 +1,209 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_SOLVE_PLAN_H
+#define F2_CMAX_SOLVE_PLAN_H
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "CostModel.h"
+#include "InstanceCache.h"
+#include "InstancePool.h"
+#include "MemoryTracker.h"
+#include "Parser.h"
+#include "ResultCache.h"
+#include "ScheduleView.h"
+#include "Shard.h"
+#include "Solver.h"
+#include "SummaryStatistics.h"
+
+/**
+ * Execution plan of the "solve" object of a config. The methods and their instances are read once, then the plan is run
+ * instance by instance: an instance file solved in memory is taken from the cache and every method that lists it is run
+ * on a copy of its jobs before moving to the next file. The instances read from a stream, solved out-of-core or as a
+ * flow shop are run in the order of the config. If a result cache is set, an instance file which did not change since a
+ * method solved it is not solved again by this method, its cached result is written instead. With a pipeline, the
+ * instance files solved in memory are run first by three stages, so that the next files are read while one is solved
+ * and its results are written (see SolvePlan::runPipeline).
+ */
+class SolvePlan {
+public:
+    // The parameters of one method of the config
+    struct Method {
+        std::string outputPath; // results of the in-memory solver
+        std::string outputOutOfCorePath;
+        std::string outputFlowShopPath;
+        bool useRevisited = true;
+        ENGINE engine = ALL;
+        unsigned int parserThreads = 1;
+        unsigned int partitionThreads = 1;
+        std::string prefixSort = "auto";
+        bool useOutOfCore = false;
+        size_t memoryBudget = 256UL << 20;
+        std::filesystem::path tmpDir;
+        std::string scheduleDir; // if not empty, the schedule of each instance is written in this directory
+        bool useFlowShop = false;
+        unsigned int nbThreads = 1; // threads of the flow shop solver
+    };
+
+    // One instance of one method, it is a file or a file descriptor
+    struct Task {
+        size_t method;
+        std::string path;
+        int fileDescriptor = -1; // if not negative, the instance is read from this file descriptor
+    };
+
+private:
+    std::vector<Method> methods;
+    std::vector<Task> tasks; // in the order of the config
+    char verbose = 0;
+    CostModel costModel; // loaded only if a method uses the engine "auto"
+    std::string resultCachePath; // if empty, the results are not cached
+    bool forceSolve = false; // if true, the cached results are not used but they are updated
+    size_t memoryLimit = 0; // in bytes, 0 for no limit
+    size_t pipelineDepth = 0; // instances read ahead of the solver, 0 to run without a pipeline
+    std::unique_ptr<SummaryStatistics> summary; // if set, the results of the in-memory solver are summarized
+    std::string summaryPath;
+    bool writeRows = true; // if false, only the summary of the results of the in-memory solver is written
+
+    /**
+     * Method that tells if a task is solved in memory from an instance file.
+     */
+    [[nodiscard]] bool isInMemory(const Task &task) const;
+
+    /**
+     * Method that gives the tasks of the same instance file as a task which are not done yet, they are run together.
+     * @param indexTask The index of the first task of the file
+     * @param done The tasks already done
+     * @param parserThreads The most threads asked by the methods of the tasks to parse the file
+     * @param splitWhileParsing If all the methods of the tasks solve the instance split while it is read
+     * @return The indices of the tasks of the file
+     */
+    std::vector<size_t> findSameFile(size_t indexTask, const std::vector<bool> &done, unsigned int &parserThreads, bool &splitWhileParsing) const;
+
+    /**
+     * Method that tells if a method may solve an instance whose jobs are split into the sets A and B while they are read:
+     * the engines "all" and "permutation" and the schedules need the jobs in the order of the file.
+     * @param method The method
+     * @return True if the jobs can be split while they are read
+     */
+    static bool isSplitWhileReading(const Method &method);
+
+    /**
+     * Method that solves an instance in memory and writes its results.
+     * @param indexMethod The index of the method
+     * @param instance The instance, it is modified by the solver
+     * @param parseMemory The memory used to load the instance
+     * @param rowStream If set, the results are written in this stream as a row of the results file of the method,
+     * instead of in this file
+     * @return The result of the instance
+     */
+    ResultCache::Result runInMemory(size_t indexMethod, Instance &instance, const MemoryUsage &parseMemory, std::ostream *rowStream = nullptr);
+
+    /**
+     * Method that adds the result of an instance to the summary.
+     * @param indexMethod The index of the method
+     * @param result The result
+     * @param times The times of the solver, NaN for a cached result
+     */
+    void addToSummary(size_t indexMethod, const ResultCache::Result &result, const std::array<double, Solver::NB_TIMES> &times);
+
+    /**
+     * Method that runs the tasks solved in memory from instance files as a pipeline of three threads: a reader parses the
+     * next files into a ring of pipelineDepth instances, the solver runs the methods of each file, and a writer appends
+     * the rows to the results files. The stages are connected by bounded SpscQueue, so that at most pipelineDepth files
+     * are loaded ahead of the solver. The time each stage was busy is reported, the busiest stage is the bottleneck.
+     * @param parser The parser of the instance files
+     * @param instanceCache The cache of the parsed instances, it is used only by the reader
+     * @param resultCache The cache of the results, nullptr if the results are not cached
+     * @param instancePool The pool of the instances of the ring
+     * @param done The tasks done, the tasks run by the pipeline are set
+     */
+    void runPipeline(const Parser &parser, InstanceCache &instanceCache, ResultCache *resultCache, InstancePool &instancePool, std::vector<bool> &done);
+
+    /**
+     * Method that throws an exception if the memory in use plus the estimated memory of an instance file exceeds the
+     * memory limit, so that the run fails before loading the instance rather than when the system runs out of memory.
+     * @param path The path of the instance file
+     * @param sameFile The tasks of the file
+     */
+    void checkMemoryLimit(const std::string &path, const std::vector<size_t> &sameFile) const;
+
+    /**
+     * Method that reads the number of jobs of an instance file from its attribute "n:", without parsing its jobs. Without
+     * this attribute, it is an upper bound computed from the size of the file.
+     */
+    static size_t peekNbJobs(const std::string &path);
+
+    /**
+     * Method that writes the schedule of an instance in the directory of the schedules of the method.
+     * @param method The method
+     * @param instance The instance
+     * @param schedule The schedule of the instance
+     */
+    void writeSchedule(const Method &method, const Instance &instance, const ScheduleView &schedule) const;
+
+    void runOutOfCore(const Method &method, std::string &path) const;
+
+    void runFlowShop(const Method &method, std::string &path, const Parser &parser) const;
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor that reads the methods and the instances of the "solve" object of a config.
+     * @param paramSolve The "solve" object
+     * @param shard The shard of the run, only its instances are kept and its results files are suffixed
+     */
+    explicit SolvePlan(const nlohmann::json &paramSolve, const Shard &shard = Shard());
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that runs the plan and writes the results of each method.
+     * @param parser The parser of the instance files
+     * @param instanceCache The cache of the parsed instances, shared by the configs
+     * @param instancePool The pool of the instances given to the solvers
+     */
+    void run(const Parser &parser, InstanceCache &instanceCache, InstancePool &instancePool);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] const std::vector<Method> &getMethods() const { return methods; }
+
+    [[nodiscard]] const std::vector<Task> &getTasks() const { return tasks; }
+};
+
+#endif //F2_CMAX_SOLVE_PLAN_H
@@ -24,40 +24,102 @@
 #ifndef F2_CMAX_SOLVER_H
 #define F2_CMAX_SOLVER_H
 
+#include <array>
+#include <memory>
 #include <random>
 
+#include "CostModel.h"
 #include "Instance.h"
+#include "MemoryTracker.h"
+#include "ParallelPartition.h"
 #include "RadixSort.h"
+#include "ScheduleView.h"
+#include "Trace.h"
 
 enum PIVOT_RULE{BFPRT};
+enum MEMORY_PHASE{PARSE_MEMORY, SPLIT_MEMORY, SORT_MEMORY, EVALUATE_MEMORY, NB_MEMORY_PHASES}; // phases whose memory is reported
+enum PREFIX_SORT{RADIX_SORT, COUNTING_SORT, KEY_SORT, AUTO_SORT}; // engine used to sort the prefix found by the revisited algorithm
 class Solver {
+public:
+    static constexpr size_t NB_TIMES = 10;
+    // names of the time columns of the results file, in the order of getTimes
+    static constexpr std::array<const char*, NB_TIMES> TIME_COLUMNS{"TimeJohnsonSTL", "TimeEvaluateJohnsonSTL",
+        "TimeJohnsonRadix", "TimeEvaluateJohnsonRadix", "TimeJohnsonPermutation", "TimeEvaluateJohnsonPermutation",
+        "TimeCmaxOnly", "TimeRevisitedJohnson", "TimeEvaluateRevisitedJohnson", "TimeRevisitedPrefixSort"};
+
+private:
     Instance * instance = nullptr;
     bool useRevisitedAlgo = true;
-    std::chrono::duration<double> time_elapsed_johnson_STL;
-    std::chrono::duration<double> time_elapsed_johnson_RADIX;
-    std::chrono::duration<double> time_elapsed_evaluating_johnson_STL;
-    std::chrono::duration<double> time_elapsed_evaluating_johnson_RADIX;
-    std::chrono::duration<double> time_elapsed_revisited_johnson;
-    std::chrono::duration<double> time_elapsed_evaluating_revisited_johnson;
+    std::chrono::duration<double> time_elapsed_johnson_STL{};
+    std::chrono::duration<double> time_elapsed_johnson_RADIX{};
+    std::chrono::duration<double> time_elapsed_evaluating_johnson_STL{};
+    std::chrono::duration<double> time_elapsed_evaluating_johnson_RADIX{};
+    std::chrono::duration<double> time_elapsed_johnson_permutation{};
+    std::chrono::duration<double> time_elapsed_evaluating_johnson_permutation{};
+    std::chrono::duration<double> time_elapsed_revisited_johnson{};
+    std::chrono::duration<double> time_elapsed_evaluating_revisited_johnson{};
+    std::chrono::duration<double> time_elapsed_revisited_prefix_sort{}; // part of the revisited time used to sort the prefixes
+    std::chrono::duration<double> time_elapsed_cmax_only{};
     enum SIDE{A,B};
     PIVOT_RULE pivotRule;
+    PREFIX_SORT prefixSort = AUTO_SORT;
+    unsigned int partitionThreads = 1; // threads of the partitions of the selection, see ParallelPartition
+    std::unique_ptr<ParallelPartition> partitionTeam; // team of the partitions, created by the first large partition
+    ENGINE engine = ALL; // engine asked by the user
+    ENGINE selectedEngine = ALL; // engine really used, it differs from the asked one only with AUTO
+    const CostModel * costModel = nullptr; // cost model used to select the engine with AUTO
     // metrics where e have ppt1, k_a, ppt2, k_b
     std::tuple<size_t,size_t,size_t,size_t,size_t,size_t> metrics;
+    std::array<size_t,2> runs{}; // presortedness of the sets A and B before their sort, as their number of runs
+    std::vector<uint32_t> permutation; // Johnson's order computed by the engine PERMUTATION, as indices in the list of jobs
+    bool permutationInFileOrder = true; // if false, the list of jobs was split before the permutation, its indices are not the ids
+    std::vector<Instance::Job, JobAllocator<Instance::Job>> cmaxOnlyBuffer; // copy of a set sorted by cmaxOnly when no proposition holds on it
     double objective;
+    std::array<MemoryUsage,NB_MEMORY_PHASES> memoryUsage{}; // the parsing is measured by the caller, see setParseMemory
+    size_t peakRSS = 0; // peak resident set size at the end of solve
 public:
     explicit Solver(Instance* instance,bool useRevisitedAlgo) : instance(instance),useRevisitedAlgo(useRevisitedAlgo), time_elapsed_johnson_STL(0),time_elapsed_revisited_johnson(0), pivotRule(BFPRT) {}
 
     void solve() {
-        instance->getJobsSmallerOnM1().reserve(instance->getNbJobs());
-        instance->getJobsSmallerOnM2().reserve(instance->getNbJobs());
+        TRACE_SCOPE("Solver::solve");
+        if (engine != ALL) {
+            solveWithEngine();
+            // the engines PERMUTATION and CMAX_ONLY do not sort the sets A and B used by the metrics
+            if (selectedEngine != PERMUTATION && selectedEngine != CMAX_ONLY) computeMetrics();
+            peakRSS = MemoryTracker::getPeakRSS();
+            return;
+        }
+        selectedEngine = ALL;
+        instance->clearListJobs();
+
+        // Johnson Algorithm with the permutation, the jobs are not moved, it must run before the split of the jobs
+        // Measure time to compute the permutation and to evaluate it
+        auto start = std::chrono::steady_clock::now();
+        JohnsonAlgorithmPermutation();
+        auto endPermutation = std::chrono::steady_clock::now();
+        time_elapsed_johnson_permutation = std::chrono::duration<double>{endPermutation - start};
+        start = std::chrono::steady_clock::now();
+        auto cmax4 = evaluatePermutation();
+        endPermutation = std::chrono::steady_clock::now();
+        time_elapsed_evaluating_johnson_permutation = std::chrono::duration<double>{endPermutation - start};
+
+        // Optimal makespan without schedule
+        start = std::chrono::steady_clock::now();
+        auto cmax5 = cmaxOnly();
+        endPermutation = std::chrono::steady_clock::now();
+        time_elapsed_cmax_only = std::chrono::duration<double>{endPermutation - start};
+        instance->clearListJobs();
 
         // Johnson Algorithm with STL
         // Measure time to compute set A and B and compute optimal solution
-        auto start = std::chrono::steady_clock::now();
-        for (auto &[pi1,pi2] : instance->getListJobs() )
-            instance->addJobOnMachinesJohnson(pi1,pi2);
+        start = std::chrono::steady_clock::now();
+        {
+            MemoryTracker::Scope memoryScope(memoryUsage[SPLIT_MEMORY]);
+            instance->splitJobsJohnson();
+        }
         auto endSolve = std::chrono::steady_clock::now();
         time_elapsed_johnson_STL = std::chrono::duration<double>{endSolve - start};
+        countRuns();
 
         // shuffle list jobs to start from scratch
         std::shuffle(instance->getJobsSmallerOnM1().begin(), instance->getJobsSmallerOnM1().end(), std::mt19937(std::random_device()()));
@@ -75,8 +137,10 @@ public:
         // Measure time to compute set A and B and compute optimal solution
         start = std::chrono::steady_clock::now();
         instance->clearListJobs();
-        for (auto &[pi1,pi2] : instance->getListJobs() )
-            instance->addJobOnMachinesJohnson(pi1,pi2);
+        {
+            MemoryTracker::Scope memoryScope(memoryUsage[SPLIT_MEMORY]);
+            instance->splitJobsJohnson();
+        }
         endSolve = std::chrono::steady_clock::now();
         time_elapsed_johnson_RADIX = std::chrono::duration<double>{endSolve - start};
 
@@ -98,8 +162,10 @@ public:
             instance->clearListJobs();
 
             // Revisited Johnson Algorithm
-            for (auto &[pi1,pi2] : instance->getListJobs() )
-                instance->addJobOnMachinesJohnson(pi1,pi2);
+            {
+                MemoryTracker::Scope memoryScope(memoryUsage[SPLIT_MEMORY]);
+                instance->splitJobsJohnson();
+            }
             // Measure time to compute set A and B and compute optimal solution.
             start = std::chrono::steady_clock::now();
             instance->addJobOnMachinesRevisitedJohnson();
@@ -124,10 +190,137 @@ public:
         if (useRevisitedAlgo && (std::fabs(cmax1-cmax3) > 1E-6 || std::fabs(cmax1-cmax2) > 1E-6 || std::fabs(cmax2-cmax3) > 1E-6)) {
             throw F2CmaxException(("Not same Cmax: revisited ->" + std::to_string(cmax1) + " johnson: " + std::to_string(cmax3)).c_str());
         }
+        if (std::fabs(cmax4-cmax3) > 1E-6) {
+            throw F2CmaxException(("Not same Cmax: permutation ->" + std::to_string(cmax4) + " johnson: " + std::to_string(cmax3)).c_str());
+        }
+        if (std::fabs(cmax5-cmax3) > 1E-6) {
+            throw F2CmaxException(("Not same Cmax: cmaxOnly ->" + std::to_string(cmax5) + " johnson: " + std::to_string(cmax3)).c_str());
+        }
         // compute the sum of pj etc if we do not already do it by using revisited algo.
         if (not useRevisitedAlgo) {
             instance->addJobOnMachinesRevisitedJohnson();
         }
+        computeMetrics();
+        objective = cmax3;
+        peakRSS = MemoryTracker::getPeakRSS();
+    }
+
+    /**
+     * Method that estimates the peak number of bytes used by the jobs of an instance and by an engine, to check a memory
+     * budget before loading the instance: the list of jobs and the largest buffer of the engine (the radix sorts use a
+     * buffer as large as the sorted set).
+     * @param nbJobs The number of jobs of the instance
+     * @param engine The engine asked by the user
+     * @return The estimated number of bytes
+     */
+    static size_t estimateMemory(size_t nbJobs, ENGINE engine) {
+        size_t bytesPerJob = sizeof(Instance::Job);
+        switch (engine) {
+            case STL: break;
+            case RADIX:
+            case REVISITED:
+            case AUTO: bytesPerJob += sizeof(Instance::Job); break;
+            case PERMUTATION: bytesPerJob += 2 * sizeof(RadixKeyIndex) + sizeof(uint32_t); break;
+            case CMAX_ONLY:
+            case ALL: bytesPerJob += 2 * sizeof(Instance::Job); break;
+        }
+        return nbJobs * bytesPerJob;
+    }
+
+    /**
+     * Method that solves the instance with only one engine. The split of jobs into A and B is done in one pass with the
+     * sums of processing times, which gives the features used by the cost model with AUTO. The time of the split is
+     * counted in the time of the engine.
+     */
+    void solveWithEngine() {
+        TRACE_SCOPE("Solver::solveWithEngine");
+        // an instance split while it was read keeps its split, the split overlapped the reading and is not timed
+        bool splitWhileReading = instance->isSplitWhileReading();
+        if (!splitWhileReading || engine == PERMUTATION) instance->clearListJobs();
+
+        if (engine == PERMUTATION) {
+            selectedEngine = PERMUTATION;
+            auto start = std::chrono::steady_clock::now();
+            JohnsonAlgorithmPermutation();
+            auto endSolve = std::chrono::steady_clock::now();
+            time_elapsed_johnson_permutation = std::chrono::duration<double>{endSolve - start};
+            start = std::chrono::steady_clock::now();
+            objective = evaluatePermutation();
+            endSolve = std::chrono::steady_clock::now();
+            time_elapsed_evaluating_johnson_permutation = std::chrono::duration<double>{endSolve - start};
+            return;
+        }
+        if (engine == CMAX_ONLY) {
+            selectedEngine = CMAX_ONLY;
+            auto start = std::chrono::steady_clock::now();
+            objective = cmaxOnly();
+            auto endSolve = std::chrono::steady_clock::now();
+            time_elapsed_cmax_only = std::chrono::duration<double>{endSolve - start};
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (!splitWhileReading) {
+            MemoryTracker::Scope memoryScope(memoryUsage[SPLIT_MEMORY]);
+            instance->splitJobsRevisitedJohnson();
+        }
+        selectedEngine = engine;
+        if (engine == AUTO) {
+            if (costModel == nullptr) throw F2CmaxException("No cost model is set to select the engine automatically");
+            selectedEngine = costModel->selectEngine(CostModel::computeFeatures(*instance), useRevisitedAlgo);
+        }
+        // the presortedness of the sets is measured before their sort, it is not counted in the time of the engine, except
+        // with RADIX whose adaptive sort counts the runs in the scan which chooses between merging them and the radix sort
+        if (selectedEngine != RADIX) {
+            auto startRuns = std::chrono::steady_clock::now();
+            countRuns();
+            start += std::chrono::steady_clock::now() - startRuns;
+        }
+        switch (selectedEngine) {
+            case STL: {
+                JohnsonAlgorithmSTL();
+                auto endSolve = std::chrono::steady_clock::now();
+                time_elapsed_johnson_STL = std::chrono::duration<double>{endSolve - start};
+                start = std::chrono::steady_clock::now();
+                objective = evaluate();
+                endSolve = std::chrono::steady_clock::now();
+                time_elapsed_evaluating_johnson_STL = std::chrono::duration<double>{endSolve - start};
+                break;
+            }
+            case RADIX: {
+                runs = JohnsonAlgorithmRadix();
+                auto endSolve = std::chrono::steady_clock::now();
+                time_elapsed_johnson_RADIX = std::chrono::duration<double>{endSolve - start};
+                start = std::chrono::steady_clock::now();
+                objective = evaluate();
+                endSolve = std::chrono::steady_clock::now();
+                time_elapsed_evaluating_johnson_RADIX = std::chrono::duration<double>{endSolve - start};
+                break;
+            }
+            case REVISITED: {
+                if (instance->getSumPa1()+instance->getSumPb2() > instance->getSumPa2() + instance->getSumPb1()) {
+                    instance->swapMachines();
+                }
+                RevisitedJohnsonAlgorithm();
+                auto endSolve = std::chrono::steady_clock::now();
+                time_elapsed_revisited_johnson = std::chrono::duration<double>{endSolve - start};
+                start = std::chrono::steady_clock::now();
+                objective = EvaluateRevisitedAlgorithm();
+                endSolve = std::chrono::steady_clock::now();
+                time_elapsed_evaluating_revisited_johnson = std::chrono::duration<double>{endSolve - start};
+                break;
+            }
+            default:
+                throw F2CmaxException("The engine cannot be used alone");
+        }
+    }
+
+    /**
+     * Method that computes the metrics PptA, K_a, K_a_p, PptB, K_b, K_b_p. The sums of processing times must be computed.
+     */
+    void computeMetrics() {
+        TRACE_SCOPE("Solver::computeMetrics");
+        metrics = {0,0,0,0,0,0};
         bool conditionProp2 = instance->getSumPa1() <= instance->getSumPa2() - instance->getPMaxA();
         bool conditionProp3 = instance->getSumPb1() <= instance->getSumPb2() - instance->getPMaxB();
         bool conditionProp5 = instance->getSumPa1()+instance->getSumPb2() <= instance->getSumPa2() + instance->getSumPb1() - std::max(instance->getPMaxA(),instance->getPMaxB());
@@ -152,11 +345,10 @@ public:
                 std::get<5>(metrics) = k_b_p;
             }
         }
-        objective = cmax3;
     }
 
     std::pair<size_t,size_t> compute_k_index(SIDE side) {
-        auto &listJob = side == A ? instance->getJobsSmallerOnM1() : instance->getJobsSmallerOnM2();
+        auto listJob = side == A ? instance->getJobsSmallerOnM1() : instance->getJobsSmallerOnM2();
 
         // identify the smallest index in johnson order
         size_t k = 1;
@@ -179,21 +371,117 @@ public:
         return {k,k_p+1};
     }
 
-    void JohnsonAlgorithmRadix() {
-        auto &jobsM1 = instance->getJobsSmallerOnM1();
-        radixsort_by_first(jobsM1);
-        auto &jobsM2 = instance->getJobsSmallerOnM2();
-        radixsort_by_first(jobsM2);
+    /**
+     * Method that sorts the sets A and B with the radix sort, or by merging their runs if they are presorted with a few
+     * perturbations (see adaptivesort_by_first).
+     * @return The number of runs of the sets A and B before their sort, found by the same scan as the sort
+     */
+    std::array<size_t,2> JohnsonAlgorithmRadix() {
+        TRACE_SCOPE("Solver::JohnsonAlgorithmRadix");
+        MemoryTracker::Scope memoryScope(memoryUsage[SORT_MEMORY]);
+        auto jobsM1 = instance->getJobsSmallerOnM1();
+        size_t runsM1 = adaptivesort_by_first(jobsM1.begin(), jobsM1.end());
+        auto jobsM2 = instance->getJobsSmallerOnM2();
+        size_t runsM2 = adaptivesort_by_first(jobsM2.begin(), jobsM2.end());
+        return {runsM1, runsM2};
+    }
+
+    /**
+     * Method that measures the presortedness of the sets A and B by their number of runs (see count_runs_by_first).
+     * The jobs must be split and not yet sorted.
+     */
+    void countRuns() {
+        TRACE_SCOPE("Solver::countRuns");
+        auto jobsM1 = instance->getJobsSmallerOnM1();
+        auto jobsM2 = instance->getJobsSmallerOnM2();
+        runs = {count_runs_by_first(jobsM1.begin(), jobsM1.end()), count_runs_by_first(jobsM2.begin(), jobsM2.end())};
+    }
+
+    /**
+     * Method that computes Johnson's order as a permutation of the list of jobs, without moving the jobs.
+     * @see Solver::computeJohnsonOrder
+     */
+    void JohnsonAlgorithmPermutation() {
+        TRACE_SCOPE("Solver::JohnsonAlgorithmPermutation");
+        MemoryTracker::Scope memoryScope(memoryUsage[SORT_MEMORY]);
+        permutationInFileOrder = instance->isInFileOrder();
+        computeJohnsonOrder(instance->getListJobs(), permutation);
+    }
+
+    /**
+     * Method that computes Johnson's order of a list of jobs as a permutation of its indices. A record (key, index) of 12
+     * bytes is built for each job: the key is p1 for a job of A and the complement of p2 for a job of B, so that B is
+     * sorted in decreasing order of p2. The records of A are put at the beginning of the buffer and the ones of B at the
+     * end, each part is sorted by the radix sort of records and the indices give the permutation.
+     * @param listJobs The jobs, not split into the sets A and B
+     * @param order The permutation to fill
+     */
+    static void computeJohnsonOrder(std::span<const Instance::Job> listJobs, std::vector<uint32_t> &order) {
+        size_t nbJobs = listJobs.size();
+        std::vector<RadixKeyIndex, JobAllocator<RadixKeyIndex>> records(nbJobs);
+        size_t endA = 0;
+        size_t beginB = nbJobs;
+        for (size_t indexJob = 0; indexJob < nbJobs; ++indexJob) {
+            auto &[pi1,pi2] = listJobs[indexJob];
+            if (pi1 < pi2) records[endA++] = {radix_ordered_key(pi1), static_cast<uint32_t>(indexJob)};
+            else records[--beginB] = {~radix_ordered_key(pi2), static_cast<uint32_t>(indexJob)};
+        }
+        radixsort_key_index(records.data(), endA);
+        radixsort_key_index(records.data() + beginB, nbJobs - beginB);
+        order.resize(nbJobs);
+        for (size_t position = 0; position < nbJobs; ++position) order[position] = records[position].index;
     }
 
     void JohnsonAlgorithmSTL() {
-        auto &jobsM1 = instance->getJobsSmallerOnM1();
+        TRACE_SCOPE("Solver::JohnsonAlgorithmSTL");
+        MemoryTracker::Scope memoryScope(memoryUsage[SORT_MEMORY]);
+        auto jobsM1 = instance->getJobsSmallerOnM1();
         std::sort(jobsM1.begin(),jobsM1.end(),[](auto &jobLeft,auto &jobRight){return jobLeft.first < jobRight.first;});
-        auto &jobsM2 = instance->getJobsSmallerOnM2();
+        auto jobsM2 = instance->getJobsSmallerOnM2();
         std::sort(jobsM2.begin(),jobsM2.end(),[](auto &jobLeft,auto &jobRight){return jobLeft.first < jobRight.first;});
     }
 
+    /**
+     * Method that sorts by Johnson's order the first k jobs of a set with the prefix sort engine.
+     * @param listJobs The set of jobs
+     * @param k The size of the prefix to sort
+     * @param pMaxSide The maximum processing time on the first machine of the set, used by the counting sort
+     */
+    void sortPrefix(std::span<Instance::Job> listJobs, size_t k, double pMaxSide) {
+        TRACE_SCOPE("Solver::sortPrefix");
+        auto start = std::chrono::steady_clock::now();
+        auto itEnd = listJobs.begin() + static_cast<long>(k);
+        PREFIX_SORT engineSort = prefixSort;
+        // the counters of the counting sort are bounded by the size of the prefix
+        bool smallKeys = pMaxSide <= 2.0 * static_cast<double>(k);
+        if (engineSort == AUTO_SORT) {
+            // a comparison sort is the fastest on small prefixes, then the counting sort if the range of keys is small
+            if (k < 256) engineSort = KEY_SORT;
+            else if (smallKeys) engineSort = COUNTING_SORT;
+            else engineSort = RADIX_SORT;
+        }
+        switch (engineSort) {
+            case COUNTING_SORT:
+                // fall back on the radix sort if the range of keys is large or if the processing times are not integers
+                if (smallKeys && countingsort_by_first(listJobs.begin(), itEnd, static_cast<size_t>(pMaxSide))) break;
+                [[fallthrough]];
+            case RADIX_SORT:
+                radixsort_by_first(listJobs.begin(), itEnd);
+                break;
+            default:
+                std::sort(listJobs.begin(), itEnd, [](auto &jobLeft,auto &jobRight){return jobLeft.first < jobRight.first;});
+                break;
+        }
+        auto endSort = std::chrono::steady_clock::now();
+        time_elapsed_revisited_prefix_sort += std::chrono::duration<double>{endSort - start};
+    }
+
     void RevisitedJohnsonAlgorithm() {
+        TRACE_SCOPE("Solver::RevisitedJohnsonAlgorithm");
+        MemoryTracker::Scope memoryScope(memoryUsage[SORT_MEMORY]);
+        time_elapsed_revisited_prefix_sort = std::chrono::duration<double>{0};
+        auto jobsM1 = instance->getJobsSmallerOnM1();
+        auto jobsM2 = instance->getJobsSmallerOnM2();
         // Attention, on set B, we work with reverse flo shop instance, i.e. all jobs on machine M1 are in fact on machine M2 and vice versa.
         bool conditionProp2 = instance->getSumPa1() <= instance->getSumPa2() - instance->getPMaxA();
         bool conditionProp3 = instance->getSumPb1() <= instance->getSumPb2() - instance->getPMaxB();
@@ -201,26 +489,26 @@ public:
         bool conditionProp6 = instance->getSumPa2() + instance->getSumPb1() <= instance->getSumPa1()+instance->getSumPb2() - std::max(instance->getPMaxA(),instance->getPMaxB());
         if (conditionProp5) {
             //with version using pivot
-            size_t k_a = find_smallest_k_and_sort(instance->getJobsSmallerOnM1(),A);
-            std::sort(instance->getJobsSmallerOnM1().begin(), instance->getJobsSmallerOnM1().begin() + k_a);
+            size_t k_a = find_smallest_k_and_sort(jobsM1,A);
+            sortPrefix(jobsM1, k_a, instance->getPMaxA());
         } else if (conditionProp6) {
             //with version using pivot
-            size_t k_b = find_smallest_k_and_sort(instance->getJobsSmallerOnM2(),B);
-            std::sort(instance->getJobsSmallerOnM2().begin(), instance->getJobsSmallerOnM2().begin() + k_b);
+            size_t k_b = find_smallest_k_and_sort(jobsM2,B);
+            sortPrefix(jobsM2, k_b, instance->getPMaxB());
         } else if (not conditionProp2 && not conditionProp3) {
             //sort both
-            std::sort(instance->getJobsSmallerOnM1().begin(), instance->getJobsSmallerOnM1().end());
-            std::sort(instance->getJobsSmallerOnM2().begin(), instance->getJobsSmallerOnM2().end());
+            sortPrefix(jobsM1, jobsM1.size(), instance->getPMaxA());
+            sortPrefix(jobsM2, jobsM2.size(), instance->getPMaxB());
         }else {
             if (conditionProp2) {
                 //with version using pivot
-                size_t k_a = find_smallest_k_and_sort(instance->getJobsSmallerOnM1(),A);
-                std::sort(instance->getJobsSmallerOnM1().begin(), instance->getJobsSmallerOnM1().begin() + k_a);
+                size_t k_a = find_smallest_k_and_sort(jobsM1,A);
+                sortPrefix(jobsM1, k_a, instance->getPMaxA());
             }
             if (conditionProp3) {
                 //with version using pivot
-                size_t k_b = find_smallest_k_and_sort(instance->getJobsSmallerOnM2(),B);
-                std::sort(instance->getJobsSmallerOnM2().begin(), instance->getJobsSmallerOnM2().begin() + k_b);
+                size_t k_b = find_smallest_k_and_sort(jobsM2,B);
+                sortPrefix(jobsM2, k_b, instance->getPMaxB());
             }
         }
     }
@@ -287,6 +575,8 @@ public:
      * Method that evaluate a solution
      */
     double evaluate() {
+        TRACE_SCOPE("Solver::evaluate");
+        MemoryTracker::Scope memoryScope(memoryUsage[EVALUATE_MEMORY]);
         double timeM1 = 0.0;
         double timeM2 = 0.0;
 
@@ -306,28 +596,110 @@ public:
         return timeM2;
     }
 
-    size_t find_smallest_k_and_sort(std::vector<Instance::Job> & listJobs,SIDE side) {
+    /**
+     * Method that computes the optimal makespan without building the schedule, in expected linear time. In Johnson's
+     * order, the makespan is the maximum over the jobs j of the sets A and B of
+     *  - for j in A: max_j (sum_{i<j} (p_i1 - p_i2) + p_j1) + sumPA2 + sumPB1,
+     *  - for j in B: the same term on the reverse instance, + sumPB2 + sumPA1,
+     * and it is at least the load of each machine. On a set where the Proposition 2 (or 3) holds, the maximum is reached
+     * on the smallest prefix found by partition with find_smallest_k_and_sort, only this prefix is sorted. Otherwise, a
+     * copy of the set is sorted by the prefix sort engine (counting or radix sort, in linear time on large sets), so the
+     * sets A and B of the instance are never fully sorted. By the Proposition 5 (resp. 6), the term of the set B (resp. A)
+     * is smaller than the load of a machine and it is not computed.
+     * @return The optimal makespan
+     */
+    double cmaxOnly() {
+        TRACE_SCOPE("Solver::cmaxOnly");
+        MemoryTracker::Scope memoryScope(memoryUsage[SORT_MEMORY]);
+        time_elapsed_revisited_prefix_sort = std::chrono::duration<double>{0};
+        if (!instance->isSplitWhileReading()) {
+            instance->clearListJobs();
+            instance->splitJobsRevisitedJohnson();
+        }
+        double loadM1 = instance->getSumPa1() + instance->getSumPb2();
+        double loadM2 = instance->getSumPa2() + instance->getSumPb1();
+        double pMax = std::max(instance->getPMaxA(),instance->getPMaxB());
+        bool conditionProp5 = loadM1 <= loadM2 - pMax;
+        bool conditionProp6 = loadM2 <= loadM1 - pMax;
+        double cmax = std::max(loadM1, loadM2);
+        if (not conditionProp6 && not instance->getJobsSmallerOnM1().empty())
+            cmax = std::max(cmax, maxHeadTerm(A) + instance->getSumPa2() + instance->getSumPb1());
+        if (not conditionProp5 && not instance->getJobsSmallerOnM2().empty())
+            cmax = std::max(cmax, maxHeadTerm(B) + instance->getSumPb2() + instance->getSumPa1());
+        return cmax;
+    }
+
+    /**
+     * Method that computes max_j (sum_{i<j} (p_i1 - p_i2) + p_j1) over a non-empty set in Johnson's order, used by cmaxOnly.
+     * @param side The set of jobs
+     */
+    double maxHeadTerm(SIDE side) {
+        auto listJobs = side == A ? instance->getJobsSmallerOnM1() : instance->getJobsSmallerOnM2();
+        double pMaxSide = side == A ? instance->getPMaxA() : instance->getPMaxB();
+        bool conditionProp = side == A ? instance->getSumPa1() <= instance->getSumPa2() - pMaxSide
+                                       : instance->getSumPb1() <= instance->getSumPb2() - pMaxSide;
+        std::span<Instance::Job> head;
+        if (conditionProp) {
+            // after the prefix, a term is at most its sum plus pMaxSide <= 0, which is smaller than the first term
+            size_t k = std::max<size_t>(1, find_smallest_k_and_sort(listJobs, side));
+            head = listJobs.first(k);
+        } else {
+            cmaxOnlyBuffer.assign(listJobs.begin(), listJobs.end());
+            head = cmaxOnlyBuffer;
+        }
+        sortPrefix(head, head.size(), pMaxSide);
+        double sumDifference = 0.0;
+        double maxTerm = -std::numeric_limits<double>::infinity();
+        for (auto &[pi1,pi2] : head) {
+            maxTerm = std::max(maxTerm, sumDifference + pi1);
+            sumDifference += pi1 - pi2;
+        }
+        return maxTerm;
+    }
+
+    /**
+     * Method that evaluates the permutation of the list of jobs computed by JohnsonAlgorithmPermutation
+     */
+    double evaluatePermutation() {
+        TRACE_SCOPE("Solver::evaluatePermutation");
+        MemoryTracker::Scope memoryScope(memoryUsage[EVALUATE_MEMORY]);
+        auto listJobs = instance->getListJobs();
+        double timeM1 = 0.0;
+        double timeM2 = 0.0;
+        for (uint32_t indexJob : permutation) {
+            timeM1 += listJobs[indexJob].first;
+            timeM2 = std::max(timeM1, timeM2) + listJobs[indexJob].second;
+        }
+        return timeM2;
+    }
+
+    size_t find_smallest_k_and_sort(std::span<Instance::Job> listJobs,SIDE side) {
+        TRACE_SCOPE("Solver::find_smallest_k_and_sort");
         double estimated_pj = std::ceil(instance->getPMax() / instance->getNbJobs() * 20);
         auto it = listJobs.begin();
         auto pivot = 0;
-        while (not property_2_holds(listJobs,0,pivot,side)) {
-            it = std::partition(listJobs.begin(), listJobs.end(), [estimated_pj](const Instance::Job& job) {
-                return job.first <= estimated_pj;
-            });
+        // the whole set is the last prefix, in case of rounding errors between the property and the sums of the instance
+        // the team is kept for the next partitions of the solver, its threads are created once
+        if (partitionThreads > 1 && listJobs.size() >= ParallelPartition::MIN_SIZE && !partitionTeam)
+            partitionTeam = std::make_unique<ParallelPartition>(partitionThreads);
+        while (not property_2_holds(listJobs,0,pivot,side) && static_cast<size_t>(pivot) < listJobs.size()) {
+            auto isSmaller = [estimated_pj](const Instance::Job& job) { return job.first <= estimated_pj; };
+            it = partitionTeam ? partitionTeam->partition(listJobs.begin(), listJobs.end(), isSmaller)
+                               : std::partition(listJobs.begin(), listJobs.end(), isSmaller);
             pivot = std::distance(listJobs.begin(),it);
             estimated_pj *= 2.0;
         }
         return pivot;
     }
 
-    bool property_2_holds(std::vector<Instance::Job> & listJobs,size_t startIndex,size_t endIndex,SIDE side) {
+    bool property_2_holds(std::span<Instance::Job> listJobs,size_t startIndex,size_t endIndex,SIDE side) {
         double sum_diff_pj = std::accumulate(listJobs.begin() + startIndex, listJobs.begin() + endIndex, 0.0, [](double sum,Instance::Job & job) {
             return sum + job.first - job.second;
         });
         return sum_diff_pj <= (side == A ? -instance->getPMaxA() : -instance->getPMaxB());
     }
 
-    static size_t BFPRTPivot(std::vector<Instance::Job> & listJobs,size_t startIndex,size_t endIndex,size_t c=5,size_t d=2) {
+    static size_t BFPRTPivot(std::span<Instance::Job> listJobs,size_t startIndex,size_t endIndex,size_t c=5,size_t d=2) {
         assert(startIndex <= endIndex ); // right indexes
         assert(startIndex < listJobs.size());
         assert(endIndex < listJobs.size());
@@ -367,32 +739,84 @@ public:
         std::sort(listJobs.begin() + startIndex, listJobs.begin()+endIndex);
         pivot = (startIndex + endIndex) / 2;
 
-        // split in place the set of jobs
-        Instance::Job pivot_Job = listJobs[pivot];
-        //mark the pivot with infinity processing time in order to find him in O(n) and swap it to its right position
-        listJobs[pivot].first = std::numeric_limits<double>::infinity();
-        size_t loopIndexBegin = 0;
-        size_t loopIndexEnd = listJobs.size()-1;
-        while (loopIndexBegin <= loopIndexEnd) {
-            if (listJobs[loopIndexBegin].first < pivot_Job.first) loopIndexBegin++;
-            else if (listJobs[loopIndexEnd].first > pivot_Job.first) loopIndexEnd--;
-            else {
-                std::swap(listJobs[loopIndexBegin],listJobs[loopIndexEnd]);
-                loopIndexBegin++;
-                loopIndexEnd--;
-            }
-        }
-        // find position of the pivot job
-        size_t indexPivotJob = 0;
-        for (; indexPivotJob < listJobs.size();indexPivotJob++) if (listJobs[indexPivotJob].first == std::numeric_limits<double>::infinity()) {listJobs[indexPivotJob].first = pivot_Job.first; break;}
-        std::swap(listJobs[loopIndexEnd + 1],listJobs[indexPivotJob]);
-        return loopIndexEnd + 1; //return the position of the pivot
+        // split in place the set of jobs: the jobs smaller than the pivot, then the others
+        double pivotTime = listJobs[pivot].first;
+        auto itGreater = std::partition(listJobs.begin(), listJobs.end(), [pivotTime](const Instance::Job& job) {
+            return job.first < pivotTime;
+        });
+        // swap a job equal to the pivot to the boundary, it is its right position
+        std::iter_swap(itGreater, std::find_if(itGreater, listJobs.end(), [pivotTime](const Instance::Job& job) { return job.first == pivotTime; }));
+        return static_cast<size_t>(std::distance(listJobs.begin(), itGreater)); //return the position of the pivot
     }
 
     /********************/
     /*      GETTER      */
     /********************/
 
+    /**
+     * Getter of the times of the results file in seconds, named by TIME_COLUMNS. The engines which did not run have a
+     * null time.
+     */
+    [[nodiscard]] std::array<double, NB_TIMES> getTimes() const {
+        return {time_elapsed_johnson_STL.count(), time_elapsed_evaluating_johnson_STL.count(),
+                time_elapsed_johnson_RADIX.count(), time_elapsed_evaluating_johnson_RADIX.count(),
+                time_elapsed_johnson_permutation.count(), time_elapsed_evaluating_johnson_permutation.count(),
+                time_elapsed_cmax_only.count(), time_elapsed_revisited_johnson.count(),
+                time_elapsed_evaluating_revisited_johnson.count(), time_elapsed_revisited_prefix_sort.count()};
+    }
+
+    /**
+     * Getter of the time used by the selected engine to solve and evaluate the instance. It is meaningless with ALL.
+     */
+    [[nodiscard]] std::chrono::duration<double> getTimeEngine() const {
+        switch (selectedEngine) {
+            case STL: return time_elapsed_johnson_STL + time_elapsed_evaluating_johnson_STL;
+            case RADIX: return time_elapsed_johnson_RADIX + time_elapsed_evaluating_johnson_RADIX;
+            case REVISITED: return time_elapsed_revisited_johnson + time_elapsed_evaluating_revisited_johnson;
+            case PERMUTATION: return time_elapsed_johnson_permutation + time_elapsed_evaluating_johnson_permutation;
+            case CMAX_ONLY: return time_elapsed_cmax_only;
+            default: return std::chrono::duration<double>{0};
+        }
+    }
+
+    [[nodiscard]] ENGINE getSelectedEngine() const { return selectedEngine; }
+
+    [[nodiscard]] double getObjective() const { return objective; }
+
+    /**
+     * Getter of the metrics of the sets A and B (PptA, K_a, K_a_p, PptB, K_b, K_b_p), they are computed by solve.
+     */
+    [[nodiscard]] const std::tuple<size_t,size_t,size_t,size_t,size_t,size_t> &getMetrics() const { return metrics; }
+
+    /**
+     * Getter of the number of runs of the sets A and B before their sort, 0 with the engines which do not sort them.
+     */
+    [[nodiscard]] const std::array<size_t,2> &getRuns() const { return runs; }
+
+    [[nodiscard]] const MemoryUsage &getMemoryUsage(MEMORY_PHASE phase) const { return memoryUsage[phase]; }
+
+    [[nodiscard]] size_t getPeakRSS() const { return peakRSS; }
+
+    /**
+     * Getter of Johnson's order computed by the engine PERMUTATION (or ALL): the job at position i of the schedule is
+     * the job getPermutation()[i] of the instance, numbered from 0 in the order of the instance file. If the jobs of the
+     * instance were split before (by a previous solve or while they were read), their order in the file is lost and an
+     * exception is thrown: the instance must be read again.
+     */
+    [[nodiscard]] const std::vector<uint32_t> &getPermutation() const {
+        if (!permutationInFileOrder) throw F2CmaxException("The jobs of the instance were split before the permutation, their ids are lost");
+        return permutation;
+    }
+
+    /**
+     * Getter of the schedule computed by the engine PERMUTATION, as a lazy view over the jobs of the instance which
+     * gives their ids and their start and completion times. The other engines move the jobs, so the ids are lost.
+     */
+    [[nodiscard]] ScheduleView getSchedule() const {
+        if (selectedEngine != PERMUTATION) throw F2CmaxException("Only the engine \"permutation\" gives the schedule of the instance");
+        return {instance->getListJobs(), getPermutation()};
+    }
+
     [[nodiscard]] std::string getPivotRule(){
         std::string pivotName;
         switch (pivotRule) {
@@ -412,28 +836,53 @@ public:
         time_elapsed_revisited_johnson = time_elapsed;
     }
 
+    void setEngine(ENGINE newEngine) { engine = newEngine; }
+
+    void setPartitionThreads(unsigned int newPartitionThreads) {
+        partitionThreads = newPartitionThreads;
+        if (partitionTeam && partitionTeam->getNbThreads() != partitionThreads) partitionTeam.reset();
+    }
+
+    /**
+     * Setter of the memory used to parse (or copy) the instance, which is done before the solver is constructed.
+     */
+    void setParseMemory(const MemoryUsage &parseMemory) { memoryUsage[PARSE_MEMORY] = parseMemory; }
+
+    void setCostModel(const CostModel *newCostModel) { costModel = newCostModel; }
+
+    void setPrefixSort(const std::string &prefixSortName) {
+        if (prefixSortName == "radix") prefixSort = RADIX_SORT;
+        else if (prefixSortName == "counting") prefixSort = COUNTING_SORT;
+        else if (prefixSortName == "key") prefixSort = KEY_SORT;
+        else if (prefixSortName == "auto") prefixSort = AUTO_SORT;
+        else throw F2CmaxException("The prefix sort is not known for the revisited Johnson's algorithm, read \"README\" file for more details on which prefix sort to use.");
+    }
+
     void setStrategy(std::string pivotName) {
         if (pivotName == "BFPRT") pivotRule = BFPRT;
         else throw F2CmaxException("The pivot rule is not known for the revisited Johnson's algorithm, read \"README\" file for more details on which pivot rule to use.");
     }
 
-    void printOutput(std::string &fileOutputName, std::ofstream &outputFile) {
-    bool fileExists = std::filesystem::exists(fileOutputName);
-    auto filePath = std::filesystem::path(fileOutputName);
-    std::filesystem::create_directories(filePath.lexically_normal().parent_path());
-    outputFile.open(fileOutputName, std::ios::out | std::ios::app | std::ios::ate);
-    // print header
-    if (!fileExists) {
+    /**
+     * Method that writes the header of the results file.
+     * @param outputFile The stream of the results file
+     * @param useRevisitedAlgo If true, the columns of the revisited algorithm are written
+     */
+    static void printHeader(std::ostream &outputFile, bool useRevisitedAlgo) {
         outputFile <<
             "InstanceName"
             << "\t" << "InstancePath"
             << "\t" << "n"
             << "\t" << "pmax"
+            << "\t" << "Engine"
             << "\t" << "TimeJohnsonSTL"
             << "\t" << "TimeEvaluateJohnsonSTL"
             << "\t" << "TimeJohnsonRadix"
-            << "\t" << "TimeEvaluateJohnsonRadix";
-        if (useRevisitedAlgo) outputFile << "\t" << "TimeRevisitedJohnson" << "\t" << "TimeEvaluateRevisitedJohnson";
+            << "\t" << "TimeEvaluateJohnsonRadix"
+            << "\t" << "TimeJohnsonPermutation"
+            << "\t" << "TimeEvaluateJohnsonPermutation"
+            << "\t" << "TimeCmaxOnly";
+        if (useRevisitedAlgo) outputFile << "\t" << "TimeRevisitedJohnson" << "\t" << "TimeEvaluateRevisitedJohnson" << "\t" << "TimeRevisitedPrefixSort";
         outputFile
             << "\t" << "PptA"
             << "\t" << "K_a"
@@ -441,19 +890,46 @@ public:
             << "\t" << "PptB"
             << "\t" << "K_b"
             << "\t" << "K_b_p"
-            << "\t" << "Objective" << std::endl;
+            << "\t" << "RunsA"
+            << "\t" << "RunsB"
+            << "\t" << "Objective";
+        for (auto phaseName : {"Parse", "Split", "Sort", "Evaluate"})
+            outputFile << "\t" << "Mem" << phaseName << "Bytes" << "\t" << "Mem" << phaseName << "Allocs" << "\t" << "Mem" << phaseName << "Peak";
+        outputFile << "\t" << "PeakRSS" << "\t" << "Allocation" << std::endl;
     }
+
+    void printOutput(std::string &fileOutputName, std::ofstream &outputFile) {
+    TRACE_SCOPE("Solver::printOutput");
+    bool fileExists = std::filesystem::exists(fileOutputName);
+    auto filePath = std::filesystem::path(fileOutputName);
+    std::filesystem::create_directories(filePath.lexically_normal().parent_path());
+    outputFile.open(fileOutputName, std::ios::out | std::ios::app | std::ios::ate);
+    // print header
+    if (!fileExists) printHeader(outputFile, useRevisitedAlgo);
+    printRow(outputFile);
+    outputFile.close();
+}
+
+    /**
+     * Method that writes the results of the instance as one line of the results file, without its header.
+     * @param outputFile The stream of the results file
+     */
+    void printRow(std::ostream &outputFile) const {
     auto [ppt1,k_a,k_a_p,ppt2,k_b,k_b_p] = metrics;
     // write value
     outputFile << instance->getInstanceName()
                << "\t" << instance->getInstancePath().string()
                << "\t" << instance->getNbJobs()
                << "\t" << instance->getSupPj()
+               << "\t" << CostModel::getEngineName(selectedEngine)
                << "\t" << time_elapsed_johnson_STL.count()
                << "\t" << time_elapsed_evaluating_johnson_STL.count()
                << "\t" << time_elapsed_johnson_RADIX.count()
-               << "\t" << time_elapsed_evaluating_johnson_RADIX.count();
-                if (useRevisitedAlgo) outputFile << "\t" << time_elapsed_revisited_johnson.count() << "\t" << time_elapsed_evaluating_revisited_johnson.count();
+               << "\t" << time_elapsed_evaluating_johnson_RADIX.count()
+               << "\t" << time_elapsed_johnson_permutation.count()
+               << "\t" << time_elapsed_evaluating_johnson_permutation.count()
+               << "\t" << time_elapsed_cmax_only.count();
+                if (useRevisitedAlgo) outputFile << "\t" << time_elapsed_revisited_johnson.count() << "\t" << time_elapsed_evaluating_revisited_johnson.count() << "\t" << time_elapsed_revisited_prefix_sort.count();
     outputFile
                << "\t" << ppt1
                << "\t" << k_a
@@ -461,8 +937,11 @@ public:
                << "\t" << ppt2
                << "\t" << k_b
                << "\t" << k_b_p
-               << "\t" << objective << std::endl;
-    outputFile.close();
+               << "\t" << runs[0]
+               << "\t" << runs[1]
+               << "\t" << objective;
+    for (auto &usage : memoryUsage) outputFile << "\t" << usage.allocatedBytes << "\t" << usage.nbAllocations << "\t" << usage.peakBytes;
+    outputFile << "\t" << peakRSS << "\t" << AllocationPolicy::getName() << std::endl;
 }
 };
 
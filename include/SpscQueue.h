@@ -0,0 +1,120 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_SPSC_QUEUE_H
+#define F2_CMAX_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Bounded queue between one producer thread and one consumer thread, used to connect the stages of a pipeline. The items
+ * are kept in a ring of fixed capacity indexed by two counters, the number of items pushed and the number of items
+ * popped, each written by a single thread, so that push and pop are lock-free. A full queue blocks the producer and an
+ * empty queue blocks the consumer with std::atomic::wait, which sleeps in the kernel instead of spinning. Once closed,
+ * a push fails and a pop fails as soon as the queue is drained.
+ */
+template<class T>
+class SpscQueue {
+    static constexpr uint64_t CLOSED = 1ULL << 63; // bit set in both counters when the queue is closed
+
+    std::vector<T> slots;
+    alignas(64) std::atomic<uint64_t> nbPopped{0}; // written by the consumer
+    alignas(64) std::atomic<uint64_t> nbPushed{0}; // written by the producer
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the queue.
+     * @param capacity The maximal number of items in the queue, at least 1
+     */
+    explicit SpscQueue(size_t capacity) : slots(capacity == 0 ? 1 : capacity) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that adds an item at the end of the queue, it waits while the queue is full. Only the producer calls it.
+     * @param item The item
+     * @return False if the queue is closed, the item is then not added
+     */
+    bool push(T item) {
+        uint64_t pushed = nbPushed.load(std::memory_order_relaxed) & ~CLOSED;
+        uint64_t popped = nbPopped.load(std::memory_order_acquire);
+        while (true) {
+            if (popped & CLOSED) return false;
+            if (pushed - popped < slots.size()) break;
+            nbPopped.wait(popped, std::memory_order_acquire);
+            popped = nbPopped.load(std::memory_order_acquire);
+        }
+        slots[pushed % slots.size()] = std::move(item);
+        nbPushed.fetch_add(1, std::memory_order_release);
+        nbPushed.notify_one();
+        return true;
+    }
+
+    /**
+     * Method that removes the first item of the queue, it waits while the queue is empty. Only the consumer calls it.
+     * @param item The item removed
+     * @return False if the queue is closed and empty, the item is then not set
+     */
+    bool pop(T &item) {
+        uint64_t popped = nbPopped.load(std::memory_order_relaxed) & ~CLOSED;
+        uint64_t pushed = nbPushed.load(std::memory_order_acquire);
+        while ((pushed & ~CLOSED) == popped) {
+            if (pushed & CLOSED) return false;
+            nbPushed.wait(pushed, std::memory_order_acquire);
+            pushed = nbPushed.load(std::memory_order_acquire);
+        }
+        item = std::move(slots[popped % slots.size()]);
+        nbPopped.fetch_add(1, std::memory_order_release);
+        nbPopped.notify_one();
+        return true;
+    }
+
+    /**
+     * Method that closes the queue and wakes up the waiting threads. The producer closes it after its last item, and
+     * either thread closes it to stop the other one on an error.
+     */
+    void close() {
+        nbPushed.fetch_or(CLOSED, std::memory_order_acq_rel);
+        nbPopped.fetch_or(CLOSED, std::memory_order_acq_rel);
+        nbPushed.notify_all();
+        nbPopped.notify_all();
+    }
+};
+
+#endif //F2_CMAX_SPSC_QUEUE_H
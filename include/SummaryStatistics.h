@@ -0,0 +1,187 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#ifndef F2_CMAX_SUMMARY_STATISTICS_H
+#define F2_CMAX_SUMMARY_STATISTICS_H
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Solver.h"
+
+/**
+ * Streaming estimate of a quantile with the P² algorithm (Jain and Chlamtac, 1985): five markers are kept, the minimum,
+ * the maximum, the quantile and two quantiles around it, and their heights are adjusted by a piecewise parabolic
+ * interpolation at each value. The memory is constant, the first five values give the exact quantile.
+ */
+class QuantileSketch {
+    double quantile;
+    size_t count = 0;
+    std::array<double,5> heights{};
+    std::array<double,5> positions{};
+    std::array<double,5> desiredPositions{};
+    std::array<double,5> increments{};
+
+public:
+    /**
+     * Constructor of the sketch.
+     * @param quantile The quantile to estimate, in [0, 1]
+     */
+    explicit QuantileSketch(double quantile) : quantile(quantile) {}
+
+    /**
+     * Method that adds a value.
+     * @param value The value
+     */
+    void add(double value);
+
+    /**
+     * Method that gives the estimate of the quantile, 0 without values.
+     */
+    [[nodiscard]] double getValue() const;
+};
+
+/**
+ * Statistics of a stream of values: their count, mean and variance (Welford's running update), minimum, maximum and an
+ * estimate of some quantiles.
+ */
+class RunningStatistics {
+    size_t count = 0;
+    double mean = 0.0;
+    double sumSquares = 0.0; // sum of the squared deviations from the mean
+    double min = 0.0;
+    double max = 0.0;
+    std::vector<QuantileSketch> sketches;
+
+public:
+    /**
+     * Constructor of the statistics.
+     * @param quantiles The quantiles estimated
+     */
+    explicit RunningStatistics(std::span<const double> quantiles);
+
+    void add(double value);
+
+    [[nodiscard]] size_t getCount() const { return count; }
+
+    [[nodiscard]] double getMean() const { return mean; }
+
+    /**
+     * Getter of the sample standard deviation, 0 with less than two values.
+     */
+    [[nodiscard]] double getStdDev() const;
+
+    [[nodiscard]] double getMin() const { return min; }
+
+    [[nodiscard]] double getMax() const { return max; }
+
+    [[nodiscard]] const std::vector<QuantileSketch> &getSketches() const { return sketches; }
+};
+
+/**
+ * Aggregator of the results of the in-memory solver, so that a campaign of many instances gives a compact summary
+ * instead of, or in addition to, one row per instance. The results are grouped by method of the config, distribution,
+ * maximum processing time and number of jobs, and each group keeps the RunningStatistics of the time columns of the
+ * results file and of the metrics K_a and K_b.
+ */
+class SummaryStatistics {
+public:
+    static constexpr size_t NB_COLUMNS = Solver::NB_TIMES + 2; // the times, K_a and K_b
+
+    // A group of results: method index, distribution, pmax, n
+    typedef std::tuple<size_t, std::string, double, unsigned int> Group;
+
+private:
+    std::vector<double> quantiles;
+    std::vector<std::string> engineNames; // engine of each method index, written in the summary
+    std::map<Group, std::vector<RunningStatistics>> groups; // sorted, so that the summary is in a deterministic order
+
+public:
+
+    /************************/
+    /*      CONSTRUCTOR     */
+    /************************/
+
+    /**
+     * Constructor of the aggregator.
+     * @param quantiles The quantiles estimated for each column, in [0, 1]
+     */
+    explicit SummaryStatistics(std::vector<double> quantiles);
+
+    /********************/
+    /*      METHODS     */
+    /********************/
+
+    /**
+     * Method that gives the distribution of an instance from its name ("..._distribution_<law>"), "unknown" without it.
+     * @param instanceName The name of the instance
+     */
+    static std::string getDistribution(const std::string &instanceName);
+
+    /**
+     * Method that adds the result of an instance.
+     * @param group The group of the instance
+     * @param values The NB_COLUMNS values of the result, a null time (engine not run) or a NaN (cached result) is not
+     * counted
+     */
+    void add(const Group &group, const std::array<double, NB_COLUMNS> &values);
+
+    /**
+     * Method that writes the summary, one line per group and column with a value.
+     * @param outputStream The stream
+     * @param withHeader If true, the header line is written first
+     */
+    void write(std::ostream &outputStream, bool withHeader) const;
+
+    /**
+     * Method that appends the summary to a file, the header is written if the file is new.
+     * @param fileOutputName The path of the summary file
+     */
+    void printOutput(const std::string &fileOutputName) const;
+
+    /********************/
+    /*      SETTER      */
+    /********************/
+
+    /**
+     * Setter of the name of the engine of a method, written in the summary next to the index of the method.
+     * @param method The index of the method in the config
+     * @param engineName The name of the engine of the method
+     */
+    void setEngineName(size_t method, const std::string &engineName);
+
+    /********************/
+    /*      GETTER      */
+    /********************/
+
+    [[nodiscard]] size_t getNbGroups() const { return groups.size(); }
+};
+
+#endif //F2_CMAX_SUMMARY_STATISTICS_H
@@ -0,0 +1,113 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#ifndef F2_CMAX_TRACE_H
+#define F2_CMAX_TRACE_H
+
+#include <cstdint>
+#include <string>
+
+#ifdef F2_CMAX_TRACE
+#include <atomic>
+#include <chrono>
+#endif
+
+/**
+ * Tracing of the phases of a run (parsing, split, sort, evaluation, output...) in the Chrome trace format, which can be
+ * opened in Perfetto (ui.perfetto.dev) or chrome://tracing. A phase is recorded by a scoped span, TRACE_SCOPE("name") at
+ * the beginning of a block, as a complete event in a ring buffer of the thread, without any lock. The buffer of a thread
+ * which has ended is reused by the next new thread. The name must be a string literal. The tracing is compiled only with
+ * the flag F2_CMAX_TRACE (cmake -DF2_CMAX_TRACE=ON): otherwise TRACE_SCOPE is empty and the methods of Trace do nothing.
+ * When compiled, the spans are recorded once enable is called.
+ */
+class Trace {
+public:
+#ifdef F2_CMAX_TRACE
+    static constexpr bool COMPILED = true;
+    static constexpr size_t BUFFER_CAPACITY = 1UL << 16; // events kept by each buffer, the oldest ones are overwritten
+
+    // A span of one thread, from its construction to its destruction
+    class Span {
+        const char *name;
+        int64_t start;
+
+    public:
+        explicit Span(const char *name) : name(name), start(isEnabled() ? now() : -1) {}
+
+        Span(const Span &) = delete;
+
+        Span &operator=(const Span &) = delete;
+
+        ~Span() { if (start >= 0) record(name, start, now()); }
+    };
+
+    /**
+     * Method that starts recording the spans.
+     */
+    static void enable() { enabled.store(true, std::memory_order_relaxed); }
+
+    [[nodiscard]] static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Method that gives the time of the trace, in nanoseconds since the start of the program.
+     */
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    /**
+     * Method that records a complete event in the ring buffer of the calling thread.
+     * @param name The name of the event, a string literal
+     * @param start The start of the event (see Trace::now)
+     * @param end The end of the event
+     */
+    static void record(const char *name, int64_t start, int64_t end);
+
+    /**
+     * Method that writes the events of all threads in a Chrome trace file. The threads which record events must be
+     * stopped or idle.
+     * @param tracePath The path of the JSON file
+     */
+    static void write(const std::string &tracePath);
+
+private:
+    static std::atomic<bool> enabled;
+    static const std::chrono::steady_clock::time_point origin;
+#else
+    static constexpr bool COMPILED = false;
+
+    static void enable() {}
+
+    static void write(const std::string &) {}
+#endif
+};
+
+#ifdef F2_CMAX_TRACE
+#define TRACE_CONCAT_IMPL(left, right) left##right
+#define TRACE_CONCAT(left, right) TRACE_CONCAT_IMPL(left, right)
+#define TRACE_SCOPE(name) Trace::Span TRACE_CONCAT(traceSpan, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif //F2_CMAX_TRACE_H
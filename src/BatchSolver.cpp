@@ -0,0 +1,191 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "BatchSolver.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+
+namespace {
+    constexpr size_t MAX_JOBS = BatchSolver::MAX_JOBS;
+    constexpr size_t LANES = BatchSolver::LANES;
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    // one value of each lane, the operations on this type are SIMD instructions (GCC vector extension)
+    typedef double LaneVector __attribute__((vector_size(LANES * sizeof(double))));
+
+    /**
+     * A set of jobs of LANES instances, slot by slot. The key is the value sorted in increasing order: p1 on A and -p2
+     * on B, so that B is in decreasing order of p2. The other value is p2 on A and p1 on B. Empty slots have an infinite
+     * key and a null other value, so they are sorted at the end and do not change the makespan.
+     */
+    struct LaneSet {
+        LaneVector key[MAX_JOBS];
+        LaneVector other[MAX_JOBS];
+    };
+
+    /**
+     * Compare-exchange of the slots first and second on every lane: the smallest key goes in the slot first.
+     */
+    inline void compareExchange(LaneSet &set, size_t first, size_t second) {
+        LaneVector keyFirst = set.key[first];
+        LaneVector keySecond = set.key[second];
+        LaneVector otherFirst = set.other[first];
+        LaneVector otherSecond = set.other[second];
+        auto exchange = keySecond < keyFirst;
+        set.key[first] = exchange ? keySecond : keyFirst;
+        set.key[second] = exchange ? keyFirst : keySecond;
+        set.other[first] = exchange ? otherSecond : otherFirst;
+        set.other[second] = exchange ? otherFirst : otherSecond;
+    }
+
+    /**
+     * Bitonic sorting network on the first width slots of a set, width is a power of two.
+     */
+    void bitonicSort(LaneSet &set, size_t width) {
+        for (size_t k = 2; k <= width; k <<= 1) {
+            for (size_t j = k >> 1; j > 0; j >>= 1) {
+                // blocks of j slots compared with the j next ones, the direction changes every k slots
+                for (size_t block = 0; block < width; block += 2 * j) {
+                    if ((block & k) == 0) for (size_t i = block; i < block + j; ++i) compareExchange(set, i, i + j);
+                    else for (size_t i = block; i < block + j; ++i) compareExchange(set, i + j, i);
+                }
+            }
+        }
+    }
+
+    /**
+     * Makespan of an instance too large for the sorting networks.
+     */
+    double solveLarge(const double *jobs, size_t nbJobs) {
+        std::vector<std::pair<double,double>> jobsA;
+        std::vector<std::pair<double,double>> jobsB;
+        for (size_t indexJob = 0; indexJob < nbJobs; ++indexJob) {
+            double pi1 = jobs[2 * indexJob];
+            double pi2 = jobs[2 * indexJob + 1];
+            if (pi1 < pi2) jobsA.emplace_back(pi1, pi2);
+            else jobsB.emplace_back(pi2, pi1);
+        }
+        auto byFirst = [](auto &jobLeft, auto &jobRight) { return jobLeft.first < jobRight.first; };
+        std::sort(jobsA.begin(), jobsA.end(), byFirst);
+        std::sort(jobsB.begin(), jobsB.end(), byFirst);
+        double timeM1 = 0.0;
+        double timeM2 = 0.0;
+        for (auto &[pi1,pi2] : jobsA) {
+            timeM1 += pi1;
+            timeM2 = std::max(timeM1, timeM2) + pi2;
+        }
+        for (auto it = jobsB.rbegin(); it != jobsB.rend(); ++it) {
+            timeM1 += it->second;
+            timeM2 = std::max(timeM1, timeM2) + it->first;
+        }
+        return timeM2;
+    }
+}
+
+void BatchSolver::solve(const double *jobs, const uint32_t *offsets, size_t nbInstances, double *cmax) {
+    LaneSet setA;
+    LaneSet setB;
+    LaneVector infiniteLanes;
+    for (size_t lane = 0; lane < LANES; ++lane) infiniteLanes[lane] = INF;
+    for (size_t firstInstance = 0; firstInstance < nbInstances; firstInstance += LANES) {
+        size_t nbLanes = std::min(LANES, nbInstances - firstInstance);
+        std::array<bool, LANES> solvedAlone{};
+
+        size_t maxSizeSet = 1;
+        for (size_t lane = 0; lane < nbLanes; ++lane) {
+            size_t instance = firstInstance + lane;
+            size_t nbJobs = offsets[instance + 1] - offsets[instance];
+            if (nbJobs > MAX_JOBS) {
+                solvedAlone[lane] = true;
+                cmax[instance] = solveLarge(jobs + 2 * static_cast<size_t>(offsets[instance]), nbJobs);
+            } else maxSizeSet = std::max(maxSizeSet, nbJobs);
+        }
+        for (size_t slot = 0; slot < maxSizeSet; ++slot) {
+            setA.key[slot] = infiniteLanes;
+            setA.other[slot] = LaneVector{};
+            setB.key[slot] = infiniteLanes;
+            setB.other[slot] = LaneVector{};
+        }
+        size_t maxSizeA = 1;
+        size_t maxSizeB = 1;
+        for (size_t lane = 0; lane < nbLanes; ++lane) {
+            if (solvedAlone[lane]) continue;
+            size_t instance = firstInstance + lane;
+            size_t sizeA = 0;
+            size_t sizeB = 0;
+            for (size_t indexJob = offsets[instance]; indexJob < offsets[instance + 1]; ++indexJob) {
+                double pi1 = jobs[2 * indexJob];
+                double pi2 = jobs[2 * indexJob + 1];
+                if (pi1 < pi2) {
+                    setA.key[sizeA][lane] = pi1;
+                    setA.other[sizeA++][lane] = pi2;
+                } else {
+                    setB.key[sizeB][lane] = -pi2;
+                    setB.other[sizeB++][lane] = pi1;
+                }
+            }
+            maxSizeA = std::max(maxSizeA, sizeA);
+            maxSizeB = std::max(maxSizeB, sizeB);
+        }
+
+        // width of each sorting network: the smallest power of two larger than the size of the set on every lane
+        size_t widthA = 1;
+        while (widthA < maxSizeA) widthA <<= 1;
+        size_t widthB = 1;
+        while (widthB < maxSizeB) widthB <<= 1;
+        for (size_t slot = maxSizeSet; slot < std::max(widthA, widthB); ++slot) {
+            setA.key[slot] = infiniteLanes;
+            setA.other[slot] = LaneVector{};
+            setB.key[slot] = infiniteLanes;
+            setB.other[slot] = LaneVector{};
+        }
+
+        bitonicSort(setA, widthA);
+        bitonicSort(setB, widthB);
+
+        // (max,+) evaluation over the lanes
+        LaneVector timeM1{};
+        LaneVector timeM2{};
+        for (size_t slot = 0; slot < maxSizeA; ++slot) {
+            LaneVector key = setA.key[slot];
+            timeM1 += key < infiniteLanes ? key : LaneVector{};
+            timeM2 = (timeM1 > timeM2 ? timeM1 : timeM2) + setA.other[slot];
+        }
+        for (size_t slot = 0; slot < maxSizeB; ++slot) {
+            LaneVector key = setB.key[slot];
+            timeM1 += setB.other[slot];
+            timeM2 = (timeM1 > timeM2 ? timeM1 : timeM2) + (key < infiniteLanes ? -key : LaneVector{});
+        }
+        for (size_t lane = 0; lane < nbLanes; ++lane)
+            if (!solvedAlone[lane]) cmax[firstInstance + lane] = timeM2[lane];
+    }
+}
+
+std::vector<double> BatchSolver::solve(const double *jobs, const uint32_t *offsets, size_t nbInstances) {
+    std::vector<double> cmax(nbInstances, 0.0);
+    solve(jobs, offsets, nbInstances, cmax.data());
+    return cmax;
+}
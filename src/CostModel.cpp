@@ -0,0 +1,240 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "CostModel.h"
+#include "Solver.h"
+#include "Trace.h"
+
+namespace {
+    /**
+     * Least squares fit of t = coef[0] * n + coef[1] * x (without intercept). If the system is singular or a coefficient
+     * is negative, the fit is done only on the term n and the previous coefficient of x is kept.
+     * @param samples The samples (n, x, t)
+     * @param coef The coefficients to fit
+     */
+    void fitLinearCost(const std::vector<std::array<double,3>> &samples, std::array<double,2> &coef) {
+        double s_nn = 0.0, s_nx = 0.0, s_xx = 0.0, s_nt = 0.0, s_xt = 0.0;
+        for (auto &[n,x,t] : samples) {
+            s_nn += n * n;
+            s_nx += n * x;
+            s_xx += x * x;
+            s_nt += n * t;
+            s_xt += x * t;
+        }
+        if (s_nn <= 0.0) return;
+        double det = s_nn * s_xx - s_nx * s_nx;
+        if (s_xx > 0.0 && det > 1E-9 * s_nn * s_xx) {
+            double coefN = (s_nt * s_xx - s_xt * s_nx) / det;
+            double coefX = (s_nn * s_xt - s_nx * s_nt) / det;
+            if (coefN >= 0.0 && coefX >= 0.0) {
+                coef = {coefN, coefX};
+                return;
+            }
+            if (coefN < 0.0) {
+                coef = {0.0, s_xt / s_xx};
+                return;
+            }
+        }
+        coef[0] = s_nt / s_nn;
+    }
+}
+
+double CostModel::sortingWork(const InstanceFeatures &features) {
+    auto work = [](size_t m) { return m < 2 ? 0.0 : static_cast<double>(m) * std::log2(static_cast<double>(m)); };
+    return work(features.nbA) + work(features.nbB);
+}
+
+InstanceFeatures CostModel::computeFeatures(Instance &instance) {
+    TRACE_SCOPE("CostModel::computeFeatures");
+    InstanceFeatures features;
+    features.n = instance.getNbJobs();
+    features.nbA = instance.getJobsSmallerOnM1().size();
+    features.nbB = instance.getJobsSmallerOnM2().size();
+    features.prop2 = instance.getSumPa1() <= instance.getSumPa2() - instance.getPMaxA();
+    features.prop3 = instance.getSumPb1() <= instance.getSumPb2() - instance.getPMaxB();
+    features.prop5 = instance.getSumPa1()+instance.getSumPb2() <= instance.getSumPa2() + instance.getSumPb1() - std::max(instance.getPMaxA(),instance.getPMaxB());
+    features.prop6 = instance.getSumPa2() + instance.getSumPb1() <= instance.getSumPa1()+instance.getSumPb2() - std::max(instance.getPMaxA(),instance.getPMaxB());
+    return features;
+}
+
+double CostModel::estimateCost(ENGINE engine, const InstanceFeatures &features) const {
+    auto n = static_cast<double>(features.nbA + features.nbB);
+    switch (engine) {
+        case STL:
+            return coefSTL[0] * n + coefSTL[1] * sortingWork(features);
+        case RADIX:
+            return coefRadix[0] * n;
+        case REVISITED: {
+            bool anyProp = features.prop2 || features.prop3 || features.prop5 || features.prop6;
+            return coefRevisited[0] * n + (anyProp ? 0.0 : coefRevisited[1] * sortingWork(features));
+        }
+        default:
+            throw F2CmaxException("Only the STL, radix and revisited engines have a cost");
+    }
+}
+
+ENGINE CostModel::selectEngine(const InstanceFeatures &features, bool allowRevisited) const {
+    TRACE_SCOPE("CostModel::selectEngine");
+    ENGINE bestEngine = RADIX;
+    double bestCost = estimateCost(RADIX, features);
+    double costSTL = estimateCost(STL, features);
+    if (costSTL < bestCost) {
+        bestEngine = STL;
+        bestCost = costSTL;
+    }
+    if (allowRevisited && estimateCost(REVISITED, features) < bestCost) bestEngine = REVISITED;
+    return bestEngine;
+}
+
+void CostModel::calibrate(const nlohmann::json &paramCalibration) {
+    TRACE_SCOPE("CostModel::calibrate");
+    unsigned int seed = 0;
+    unsigned int repetitions = 3;
+    std::vector<unsigned int> listN{1000, 10000, 100000, 1000000};
+    std::vector<unsigned int> listPMax{100, 10000};
+    std::vector<std::string> listDistributions{"uniform", "exponential", "lognormal"};
+
+    if (paramCalibration.contains("seed")) {
+        if (paramCalibration["seed"].is_number_unsigned()) seed = paramCalibration["seed"];
+        else throw std::invalid_argument(R"(The "seed" must be an unsigned integer in the "calibrate" object)");
+    }
+    if (paramCalibration.contains("repetitions")) {
+        if (paramCalibration["repetitions"].is_number_unsigned() && paramCalibration["repetitions"] > 0) repetitions = paramCalibration["repetitions"];
+        else throw std::invalid_argument(R"(The "repetitions" must be a positive integer in the "calibrate" object)");
+    }
+    if (paramCalibration.contains("n")) {
+        if (paramCalibration["n"].is_array()) listN = paramCalibration["n"].get<std::vector<unsigned int>>();
+        else throw std::invalid_argument(R"(The "n" must be an array of unsigned integers in the "calibrate" object)");
+    }
+    if (paramCalibration.contains("pmax")) {
+        if (paramCalibration["pmax"].is_array()) listPMax = paramCalibration["pmax"].get<std::vector<unsigned int>>();
+        else throw std::invalid_argument(R"(The "pmax" must be an array of unsigned integers in the "calibrate" object)");
+    }
+    if (paramCalibration.contains("distributions")) {
+        if (paramCalibration["distributions"].is_array()) listDistributions = paramCalibration["distributions"].get<std::vector<std::string>>();
+        else throw std::invalid_argument(R"(The "distributions" must be an array of strings in the "calibrate" object)");
+    }
+
+    // samples (n, sorting work, time) for each engine STL, RADIX, REVISITED
+    std::array<std::vector<std::array<double,3>>,3> samples;
+    constexpr std::array<ENGINE,3> engines{STL, RADIX, REVISITED};
+    // the generated instance is kept, each engine solves a copy of it so that no engine gets jobs sorted by another one
+    Instance generated;
+    Instance instance;
+    generated.setSeed(seed);
+    for (auto &distribution : listDistributions) {
+        for (auto pmax : listPMax) {
+            for (auto n : listN) {
+                nlohmann::json paramInstance = {{"n", n}, {"distribution", distribution}, {"pi", {{"inf", 1u}, {"sup", pmax}}}};
+                for (unsigned int repetition = 0; repetition < repetitions; ++repetition) {
+                    generated.clearListJobs();
+                    generated.generateInstance(paramInstance);
+                    // features of the instance, without any swap of machines
+                    instance = generated;
+                    instance.splitJobsRevisitedJohnson();
+                    InstanceFeatures features = computeFeatures(instance);
+                    for (size_t indexEngine = 0; indexEngine < engines.size(); ++indexEngine) {
+                        instance = generated;
+                        Solver solver(&instance, true);
+                        solver.setEngine(engines[indexEngine]);
+                        solver.solve();
+                        double work = sortingWork(features);
+                        if (engines[indexEngine] == RADIX) work = 0.0;
+                        if (engines[indexEngine] == REVISITED && (features.prop2 || features.prop3 || features.prop5 || features.prop6)) work = 0.0;
+                        samples[indexEngine].push_back({static_cast<double>(n), work, solver.getTimeEngine().count()});
+                    }
+                }
+            }
+        }
+    }
+    fitLinearCost(samples[0], coefSTL);
+    fitLinearCost(samples[1], coefRadix);
+    fitLinearCost(samples[2], coefRevisited);
+}
+
+void CostModel::loadFromFile(const std::string &filePath) {
+    std::ifstream fileStream(filePath);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(filePath).c_str());
+    nlohmann::json calibration = nlohmann::json::parse(fileStream);
+    auto readCoefficients = [&calibration](const std::string &engineName, std::array<double,2> &coef) {
+        if (!calibration.contains(engineName) || !calibration[engineName].is_array() || calibration[engineName].size() != 2)
+            throw std::invalid_argument(std::string("The calibration file must have an array of two coefficients for the engine ").append(engineName));
+        coef = calibration[engineName].get<std::array<double,2>>();
+    };
+    readCoefficients(getEngineName(STL), coefSTL);
+    readCoefficients(getEngineName(RADIX), coefRadix);
+    readCoefficients(getEngineName(REVISITED), coefRevisited);
+}
+
+void CostModel::saveToFile(const std::string &filePath) const {
+    auto path = std::filesystem::path(filePath);
+    if (path.has_parent_path()) std::filesystem::create_directories(path.lexically_normal().parent_path());
+    std::ofstream fileStream(filePath);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(filePath).c_str());
+    fileStream << toJson().dump(4) << std::endl;
+    fileStream.close();
+}
+
+void CostModel::loadOrCalibrate(const std::string &filePath) {
+    if (std::filesystem::exists(filePath)) loadFromFile(filePath);
+    else {
+        calibrate(nlohmann::json::object());
+        saveToFile(filePath);
+    }
+}
+
+nlohmann::json CostModel::toJson() const {
+    return {
+        {getEngineName(STL), coefSTL},
+        {getEngineName(RADIX), coefRadix},
+        {getEngineName(REVISITED), coefRevisited}
+    };
+}
+
+std::string CostModel::getCoefficients() const {
+    return toJson().dump();
+}
+
+std::string CostModel::getEngineName(ENGINE engine) {
+    switch (engine) {
+        case ALL: return "all";
+        case STL: return "stl";
+        case RADIX: return "radix";
+        case REVISITED: return "revisited";
+        case AUTO: return "auto";
+        case PERMUTATION: return "permutation";
+        case CMAX_ONLY: return "cmaxOnly";
+    }
+    throw F2CmaxException("The engine is not known");
+}
+
+ENGINE CostModel::getEngineFromName(const std::string &engineName) {
+    if (engineName == "all") return ALL;
+    if (engineName == "stl") return STL;
+    if (engineName == "radix") return RADIX;
+    if (engineName == "revisited") return REVISITED;
+    if (engineName == "auto") return AUTO;
+    if (engineName == "permutation") return PERMUTATION;
+    if (engineName == "cmaxOnly") return CMAX_ONLY;
+    throw F2CmaxException("The engine is not known, read \"README\" file for more details on which engine to use.");
+}
@@ -0,0 +1,314 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "ExternalSolver.h"
+#include "ScheduleView.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <queue>
+
+namespace {
+    using Record = ExternalSolver::Record;
+
+    // smallest block of records read or written at once during a merge
+    constexpr size_t MIN_BLOCK_BYTES = 64UL << 10;
+
+    /**
+     * Buffered writer of a run.
+     */
+    class RunWriter {
+        std::ofstream stream;
+        std::vector<Record> buffer;
+        size_t capacity;
+
+    public:
+        RunWriter(const std::filesystem::path &path, size_t capacity) : stream(path, std::ios::out | std::ios::binary | std::ios::trunc), capacity(std::max<size_t>(capacity, 1)) {
+            if (!stream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(path.string()).c_str());
+            buffer.reserve(this->capacity);
+        }
+
+        void push(const Record &record) {
+            buffer.push_back(record);
+            if (buffer.size() == capacity) flush();
+        }
+
+        void flush() {
+            stream.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(Record)));
+            if (!stream) throw F2CmaxException("Can't write a run of the out-of-core solver, check the free space of the temporary directory");
+            buffer.clear();
+        }
+
+        void close() {
+            flush();
+            stream.close();
+        }
+    };
+
+    /**
+     * Buffered reader of a run.
+     */
+    class RunReader {
+        std::ifstream stream;
+        std::vector<Record> buffer;
+        size_t position = 0;
+        size_t capacity = 1;
+
+    public:
+        RunReader(const std::filesystem::path &path, size_t capacity) : stream(path, std::ios::in | std::ios::binary) {
+            if (!stream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(path.string()).c_str());
+            // no need of a buffer larger than the run
+            this->capacity = std::max<size_t>(1, std::min(capacity, static_cast<size_t>(std::filesystem::file_size(path)) / sizeof(Record)));
+        }
+
+        bool next(Record &record) {
+            if (position == buffer.size()) {
+                buffer.resize(capacity);
+                stream.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(capacity * sizeof(Record)));
+                buffer.resize(static_cast<size_t>(stream.gcount()) / sizeof(Record));
+                position = 0;
+                if (buffer.empty()) return false;
+            }
+            record = buffer[position++];
+            return true;
+        }
+    };
+
+    /**
+     * Method that merges sorted runs and gives each record in order to a consumer.
+     * @param runs The runs to merge
+     * @param ascending True if the runs are sorted by increasing first value (set A), false otherwise (set B)
+     * @param blockRecords The number of records buffered for each run
+     * @param consumer The function called on each record in the merged order
+     */
+    void mergeRuns(const std::vector<std::filesystem::path> &runs, bool ascending, size_t blockRecords, const std::function<void(const Record &)> &consumer) {
+        std::vector<RunReader> readers;
+        readers.reserve(runs.size());
+        for (auto &run : runs) readers.emplace_back(run, blockRecords);
+        // the top of the heap is the next record in Johnson's order
+        auto comparator = [ascending](const std::pair<Record,size_t> &left, const std::pair<Record,size_t> &right) {
+            return ascending ? left.first.first > right.first.first : left.first.first < right.first.first;
+        };
+        std::priority_queue<std::pair<Record,size_t>, std::vector<std::pair<Record,size_t>>, decltype(comparator)> heap(comparator);
+        Record record{};
+        for (size_t indexReader = 0; indexReader < readers.size(); ++indexReader)
+            if (readers[indexReader].next(record)) heap.emplace(record, indexReader);
+        while (!heap.empty()) {
+            auto [top, indexReader] = heap.top();
+            heap.pop();
+            consumer(top);
+            if (readers[indexReader].next(record)) heap.emplace(record, indexReader);
+        }
+    }
+}
+
+ExternalSolver::ExternalSolver(std::string &instancePath, size_t memoryBudget, const std::filesystem::path &tmpDir)
+    : metadata(instancePath), memoryBudget(memoryBudget), tmpDir(tmpDir) {
+    if (memoryBudget < 4 * MIN_BLOCK_BYTES)
+        throw std::invalid_argument(std::string("The memory budget of the out-of-core solver must be at least ").append(std::to_string(4 * MIN_BLOCK_BYTES)).append(" bytes"));
+}
+
+ExternalSolver::~ExternalSolver() {
+    std::error_code errorCode;
+    if (!workingDir.empty()) std::filesystem::remove_all(workingDir, errorCode);
+}
+
+size_t ExternalSolver::getMaxFanIn() const {
+    // one block for each run and one for the output
+    return std::max<size_t>(2, memoryBudget / MIN_BLOCK_BYTES - 1);
+}
+
+void ExternalSolver::spillRun(std::vector<Record> &buffer, std::vector<std::filesystem::path> &runs, const std::string &setName) {
+    TRACE_SCOPE("ExternalSolver::spillRun");
+    if (buffer.empty()) return;
+    // Johnson's order: increasing p1 on A, decreasing p2 on B (the first value of a job of B is its p2)
+    if (setName == "A") std::sort(buffer.begin(), buffer.end(), [](const Record &left, const Record &right) { return left.first < right.first; });
+    else std::sort(buffer.begin(), buffer.end(), [](const Record &left, const Record &right) { return left.first > right.first; });
+    auto runPath = workingDir / (setName + "_run" + std::to_string(nbRuns++) + ".bin");
+    std::ofstream stream(runPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(runPath.string()).c_str());
+    stream.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(Record)));
+    if (!stream) throw F2CmaxException("Can't write a run of the out-of-core solver, check the free space of the temporary directory");
+    stream.close();
+    runs.push_back(runPath);
+    buffer.clear();
+}
+
+void ExternalSolver::reduceRuns(std::vector<std::filesystem::path> &runs, const std::string &setName) {
+    TRACE_SCOPE("ExternalSolver::reduceRuns");
+    size_t maxFanIn = getMaxFanIn();
+    while (runs.size() > maxFanIn) {
+        std::vector<std::filesystem::path> mergedRuns;
+        for (size_t indexFirstRun = 0; indexFirstRun < runs.size(); indexFirstRun += maxFanIn) {
+            std::vector<std::filesystem::path> group(runs.begin() + static_cast<long>(indexFirstRun), runs.begin() + static_cast<long>(std::min(runs.size(), indexFirstRun + maxFanIn)));
+            if (group.size() == 1) {
+                mergedRuns.push_back(group.front());
+                continue;
+            }
+            size_t blockRecords = memoryBudget / ((group.size() + 1) * sizeof(Record));
+            auto runPath = workingDir / (setName + "_run" + std::to_string(nbRuns++) + ".bin");
+            RunWriter writer(runPath, blockRecords);
+            mergeRuns(group, setName == "A", blockRecords, [&writer](const Record &record) { writer.push(record); });
+            writer.close();
+            for (auto &run : group) std::filesystem::remove(run);
+            mergedRuns.push_back(runPath);
+        }
+        runs = std::move(mergedRuns);
+    }
+}
+
+void ExternalSolver::solve() {
+    TRACE_SCOPE("ExternalSolver::solve");
+    // unique working directory for the runs
+    std::random_device rd;
+    workingDir = tmpDir / ("f2cmax_" + metadata.getInstanceName() + "_" + std::to_string(rd()));
+    std::filesystem::create_directories(workingDir);
+
+    /**********************************************/
+    /*      SPLIT IN A AND B AND FORM THE RUNS    */
+    /**********************************************/
+
+    auto start = std::chrono::steady_clock::now();
+    std::fstream fileStream(metadata.getInstancePath().lexically_normal(), std::fstream::in);
+    if (!fileStream.is_open())
+        throw F2CmaxException(std::string("Can't open the file ").append(metadata.getInstancePath().lexically_normal().string()).c_str());
+    // half of the budget for each set
+    size_t capacityRun = std::max<size_t>(1, memoryBudget / (2 * sizeof(Record)));
+    std::vector<Record> bufferA;
+    std::vector<Record> bufferB;
+    bufferA.reserve(capacityRun);
+    bufferB.reserve(capacityRun);
+    uint64_t nbReadJobs = 0;
+    bool nbJobsRead = false;
+    std::string line;
+    while (std::getline(fileStream, line)) {
+        auto pos = line.find(':');
+        if (pos == std::string::npos) {
+            if (line.empty()) continue;
+            char *endPj1 = nullptr;
+            double pj1 = std::strtod(line.c_str(), &endPj1);
+            double pj2 = std::strtod(endPj1, nullptr);
+            if (pj1 < pj2) {
+                bufferA.push_back({pj1, pj2, nbReadJobs});
+                if (bufferA.size() == capacityRun) spillRun(bufferA, runsA, "A");
+            } else {
+                bufferB.push_back({pj2, pj1, nbReadJobs}); //add the job directly regarding the reverse property
+                if (bufferB.size() == capacityRun) spillRun(bufferB, runsB, "B");
+            }
+            ++nbReadJobs;
+        } else {
+            std::string attribute = line.substr(0, pos);
+            if (attribute == "name") metadata.setInstanceName(line.substr(pos + 1));
+            else if (attribute == "n") {
+                nbJobs = std::stoull(line.substr(pos + 1));
+                nbJobsRead = true;
+            }
+        }
+    }
+    fileStream.close();
+    if (!nbJobsRead || nbJobs != nbReadJobs) throw std::invalid_argument("The number of jobs is not equals to n");
+    spillRun(bufferA, runsA, "A");
+    spillRun(bufferB, runsB, "B");
+    bufferA = std::vector<Record>();
+    bufferB = std::vector<Record>();
+    auto endSolve = std::chrono::steady_clock::now();
+    time_elapsed_run_formation = std::chrono::duration<double>{endSolve - start};
+
+    /***************************************/
+    /*      MERGE AND EVALUATE ON THE FLY   */
+    /***************************************/
+
+    start = std::chrono::steady_clock::now();
+    reduceRuns(runsA, "A");
+    reduceRuns(runsB, "B");
+    // the schedule has the format of the schedules of the in-memory solver (see ScheduleView)
+    std::ofstream scheduleStream;
+    std::optional<ScheduleView::Writer> scheduleWriter;
+    if (!scheduleDir.empty()) {
+        auto schedulePath = scheduleDir / metadata.getScheduleFileName();
+        if (schedulePath.has_parent_path()) std::filesystem::create_directories(schedulePath.lexically_normal().parent_path());
+        scheduleStream.open(schedulePath, std::ios::out | std::ios::trunc);
+        if (!scheduleStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(schedulePath.string()).c_str());
+        scheduleWriter.emplace(scheduleStream);
+    }
+    double timeM1 = 0.0;
+    double timeM2 = 0.0;
+    // Phase 1: Jobs where p_i1 < p_i2
+    size_t blockRecordsA = memoryBudget / ((runsA.size() + 1) * sizeof(Record));
+    mergeRuns(runsA, true, blockRecordsA, [&](const Record &job) {
+        double startM1 = timeM1;
+        timeM1 += job.first;
+        double startM2 = std::max(timeM1, timeM2);
+        timeM2 = startM2 + job.second;
+        if (scheduleWriter) scheduleWriter->add(job.id, startM1, timeM1, startM2, timeM2);
+    });
+    // Phase 2: Jobs where p_i1 >= p_i2, the runs of B are already in decreasing order of p2
+    size_t blockRecordsB = memoryBudget / ((runsB.size() + 1) * sizeof(Record));
+    mergeRuns(runsB, false, blockRecordsB, [&](const Record &job) {
+        double startM1 = timeM1;
+        timeM1 += job.second;
+        double startM2 = std::max(timeM1, timeM2);
+        timeM2 = startM2 + job.first;
+        if (scheduleWriter) scheduleWriter->add(job.id, startM1, timeM1, startM2, timeM2);
+    });
+    scheduleWriter.reset();
+    if (scheduleStream.is_open()) scheduleStream.close();
+    objective = timeM2;
+    endSolve = std::chrono::steady_clock::now();
+    time_elapsed_merge_evaluate = std::chrono::duration<double>{endSolve - start};
+
+    std::filesystem::remove_all(workingDir);
+    workingDir.clear();
+}
+
+void ExternalSolver::printOutput(std::string &fileOutputName, std::ofstream &outputFile) {
+    bool fileExists = std::filesystem::exists(fileOutputName);
+    auto filePath = std::filesystem::path(fileOutputName);
+    std::filesystem::create_directories(filePath.lexically_normal().parent_path());
+    outputFile.open(fileOutputName, std::ios::out | std::ios::app | std::ios::ate);
+    // print header
+    if (!fileExists) {
+        outputFile <<
+            "InstanceName"
+            << "\t" << "InstancePath"
+            << "\t" << "n"
+            << "\t" << "pmax"
+            << "\t" << "MemoryBudget"
+            << "\t" << "NbRuns"
+            << "\t" << "TimeRunFormation"
+            << "\t" << "TimeMergeEvaluate"
+            << "\t" << "Objective" << std::endl;
+    }
+    outputFile << metadata.getInstanceName()
+               << "\t" << metadata.getInstancePath().string()
+               << "\t" << nbJobs
+               << "\t" << metadata.getSupPj()
+               << "\t" << memoryBudget
+               << "\t" << nbRuns
+               << "\t" << time_elapsed_run_formation.count()
+               << "\t" << time_elapsed_merge_evaluate.count()
+               << "\t" << objective << std::endl;
+    outputFile.close();
+}
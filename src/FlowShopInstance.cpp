@@ -0,0 +1,125 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "FlowShopInstance.h"
+
+FlowShopInstance::FlowShopInstance(const std::string &newInstancePath) {
+    setInstancePath(newInstancePath);
+}
+
+FlowShopInstance::FlowShopInstance(const Instance &twoMachineInstance)
+    : instanceName(twoMachineInstance.getInstanceName()), instancePath(twoMachineInstance.getInstancePath()),
+      nbJobs(twoMachineInstance.getNbJobs()), supPj(twoMachineInstance.getSupPj()) {
+    size_t nbJobsListed = twoMachineInstance.getListJobs().size();
+    processingTimes.reserve(2 * nbJobsListed);
+    for (size_t indexJob = 0; indexJob < nbJobsListed; ++indexJob) {
+        // the jobs of B of a split instance have their processing times swapped in the list
+        auto [pi1,pi2] = twoMachineInstance.getJob(indexJob);
+        processingTimes.push_back(pi1);
+        processingTimes.push_back(pi2);
+    }
+}
+
+void FlowShopInstance::addJob(std::span<const double> jobProcessingTimes) {
+    if (jobProcessingTimes.size() != nbMachines)
+        throw std::invalid_argument("The number of processing times of a job is not equals to m");
+    processingTimes.insert(processingTimes.end(), jobProcessingTimes.begin(), jobProcessingTimes.end());
+}
+
+void FlowShopInstance::buildCDSInstance(unsigned int k, Instance &twoMachineInstance) const {
+    size_t nbAddedJobs = getNbAddedJobs();
+    twoMachineInstance.setNbJobs(static_cast<unsigned int>(nbAddedJobs));
+    for (size_t job = 0; job < nbAddedJobs; ++job) {
+        auto jobProcessingTimes = getJob(job);
+        double pi1 = 0.0;
+        double pi2 = 0.0;
+        for (unsigned int machine = 0; machine < k; ++machine) {
+            pi1 += jobProcessingTimes[machine];
+            pi2 += jobProcessingTimes[nbMachines - 1 - machine];
+        }
+        twoMachineInstance.addJob(pi1, pi2);
+    }
+}
+
+void FlowShopInstance::generateInstance(nlohmann::json &paramInstance, Instance &generator) {
+    if (paramInstance.contains("distribution")) {
+        if (paramInstance["distribution"].is_string()) generator.setDistribution(paramInstance["distribution"].get<std::string>());
+        else throw std::invalid_argument(R"(The "distribution" must be an string object)");
+    }
+    processingTimes.clear();
+    if (paramInstance.contains("m")) {
+        if (paramInstance["m"].is_number_unsigned()) setNbMachines(paramInstance["m"]);
+        else throw std::invalid_argument(R"(The "m" must be an unsigned integer)");
+    }
+    if (paramInstance.contains("n")) {
+        if (paramInstance["n"].is_number_unsigned()) setNbJobs(paramInstance["n"]);
+        else throw std::invalid_argument(R"(The "N" must be an unsigned integer)");
+    }
+
+    //set pi distribution
+    unsigned int infPi = 1;
+    unsigned int supPi = 100;
+    if (paramInstance.contains("pi")) {
+        if (paramInstance["pi"].contains("inf")) {
+            if (paramInstance["pi"]["inf"].is_number_unsigned()) infPi = paramInstance["pi"]["inf"];
+            else throw std::invalid_argument(R"(The "inf" must be an unsigned integer in the "pi" object)");
+        }
+        if (paramInstance["pi"].contains("sup")) {
+            if (paramInstance["pi"]["sup"].is_number_unsigned()) supPi = paramInstance["pi"]["sup"];
+            else throw std::invalid_argument(R"(The "sup" must be an unsigned integer in the "pi" object)");
+        }
+    }
+
+    // generate Jobs, the generator draws the processing times two by two
+    std::vector<double> jobProcessingTimes(nbMachines + 1);
+    for (unsigned int i = 0; i < nbJobs; ++i) {
+        for (unsigned int machine = 0; machine < nbMachines; machine += 2) {
+            auto [pj1,pj2] = generator.generateJob(infPi, supPi);
+            jobProcessingTimes[machine] = pj1;
+            jobProcessingTimes[machine + 1] = pj2;
+        }
+        addJob(std::span<const double>(jobProcessingTimes).first(nbMachines));
+    }
+}
+
+void FlowShopInstance::setInstanceName(const std::string &newInstanceName) {
+    instanceName = newInstanceName;
+    size_t pos1 = instanceName.find("_pmax_");
+    if (pos1 == std::string::npos) throw F2CmaxException("No '*_pmax_*' was found in the name of the instance");
+    size_t pos2 = instanceName.find('_', pos1 + 5);
+    if (pos2 == std::string::npos) throw F2CmaxException("No '*_pmax_*' was found in the name of the instance");
+    supPj = std::stod(instanceName.substr(pos1 + 6, pos2 - pos1 - 6));
+}
+
+void FlowShopInstance::setInstancePath(const std::string &newInstancePath) {
+    instancePath = std::filesystem::path(newInstancePath);
+    if (!std::filesystem::exists(instancePath) && instancePath.has_parent_path())
+        std::filesystem::create_directories(instancePath.lexically_normal().parent_path());
+    instanceName = instancePath.stem();
+}
+
+void FlowShopInstance::setNbMachines(unsigned int newNbMachines) {
+    if (newNbMachines < 2) throw std::invalid_argument(R"(The "m" must be at least 2)");
+    if (!processingTimes.empty()) throw F2CmaxException("The number of machines must be set before adding jobs");
+    nbMachines = newNbMachines;
+}
@@ -0,0 +1,266 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "FlowShopSolver.h"
+
+#include <atomic>
+#include <barrier>
+#include <limits>
+#include <thread>
+
+#include "Solver.h"
+#include "Trace.h"
+
+namespace {
+    // smallest size k*m of a partial sequence for which the insertion is split between the threads
+    constexpr size_t MIN_PARALLEL_WORK = 2048;
+
+    /**
+     * Insertion of a job at the best position of a partial sequence with Taillard's acceleration. With more than one
+     * thread, a team of threads is kept for the whole NEH: for each insertion, the heads and the tails are computed by
+     * two threads, then each thread evaluates a contiguous range of positions. The best position is the first one with
+     * the smallest makespan, whatever the number of threads.
+     */
+    class TaillardInsertion {
+        const FlowShopInstance &instance;
+        size_t nbMachines;
+        std::vector<double> heads; // heads[r*m+l]: completion time of the r first jobs of the sequence on machine l
+        std::vector<double> tails; // tails[r*m+l]: time from the start of the job r on machine l to the end
+        const std::vector<uint32_t> *partialSequence = nullptr;
+        uint32_t job = 0;
+        // team of threads, the main thread is the thread 0
+        unsigned int nbThreads;
+        std::vector<std::thread> workers;
+        std::barrier<> phaseBarrier;
+        std::atomic<bool> stop{false};
+        std::vector<std::pair<double,size_t>> bestByThread;
+
+        void computeHeads() {
+            auto &jobs = *partialSequence;
+            std::fill_n(heads.begin(), nbMachines, 0.0);
+            for (size_t r = 1; r <= jobs.size(); ++r) {
+                auto processingTimes = instance.getJob(jobs[r - 1]);
+                double *row = heads.data() + r * nbMachines;
+                const double *previousRow = row - nbMachines;
+                double completion = 0.0;
+                for (size_t l = 0; l < nbMachines; ++l) {
+                    completion = std::max(completion, previousRow[l]) + processingTimes[l];
+                    row[l] = completion;
+                }
+            }
+        }
+
+        void computeTails() {
+            auto &jobs = *partialSequence;
+            size_t k = jobs.size();
+            std::fill_n(tails.begin() + static_cast<long>(k * nbMachines), nbMachines, 0.0);
+            for (size_t r = k; r-- > 0;) {
+                auto processingTimes = instance.getJob(jobs[r]);
+                double *row = tails.data() + r * nbMachines;
+                const double *nextRow = row + nbMachines;
+                double tail = 0.0;
+                for (size_t l = nbMachines; l-- > 0;) {
+                    tail = std::max(tail, nextRow[l]) + processingTimes[l];
+                    row[l] = tail;
+                }
+            }
+        }
+
+        /**
+         * Best position among the positions first to last-1, the job is inserted before the job at this position.
+         */
+        std::pair<double,size_t> bestPosition(size_t first, size_t last) const {
+            auto processingTimes = instance.getJob(job);
+            double bestCmax = std::numeric_limits<double>::infinity();
+            size_t bestPos = first;
+            for (size_t pos = first; pos < last; ++pos) {
+                const double *headRow = heads.data() + pos * nbMachines;
+                const double *tailRow = tails.data() + pos * nbMachines;
+                double completion = 0.0;
+                double cmax = 0.0;
+                for (size_t l = 0; l < nbMachines; ++l) {
+                    completion = std::max(completion, headRow[l]) + processingTimes[l];
+                    cmax = std::max(cmax, completion + tailRow[l]);
+                }
+                if (cmax < bestCmax) {
+                    bestCmax = cmax;
+                    bestPos = pos;
+                }
+            }
+            return {bestCmax, bestPos};
+        }
+
+        void runPhases(unsigned int thread) {
+            if (thread == 0) computeHeads();
+            if (thread == 1) computeTails();
+            phaseBarrier.arrive_and_wait();
+            size_t nbPositions = partialSequence->size() + 1;
+            size_t first = nbPositions * thread / nbThreads;
+            size_t last = nbPositions * (thread + 1) / nbThreads;
+            bestByThread[thread] = first < last ? bestPosition(first, last) : std::pair{std::numeric_limits<double>::infinity(), first};
+            phaseBarrier.arrive_and_wait();
+        }
+
+    public:
+        TaillardInsertion(const FlowShopInstance &instance, unsigned int nbThreads)
+            : instance(instance), nbMachines(instance.getNbMachines()),
+              heads((instance.getNbAddedJobs() + 1) * instance.getNbMachines()),
+              tails((instance.getNbAddedJobs() + 1) * instance.getNbMachines()),
+              nbThreads(std::max(1u, nbThreads)), phaseBarrier(this->nbThreads), bestByThread(this->nbThreads) {
+            for (unsigned int thread = 1; thread < this->nbThreads; ++thread) {
+                workers.emplace_back([this, thread]() {
+                    while (true) {
+                        phaseBarrier.arrive_and_wait();
+                        if (stop.load()) return;
+                        runPhases(thread);
+                    }
+                });
+            }
+        }
+
+        ~TaillardInsertion() {
+            if (workers.empty()) return;
+            stop.store(true);
+            phaseBarrier.arrive_and_wait();
+            for (auto &worker : workers) worker.join();
+        }
+
+        TaillardInsertion(const TaillardInsertion &) = delete;
+
+        TaillardInsertion &operator=(const TaillardInsertion &) = delete;
+
+        /**
+         * Best position to insert a job in a partial sequence.
+         * @return The makespan of the partial sequence with the job and the position of the job
+         */
+        std::pair<double,size_t> insert(const std::vector<uint32_t> &jobs, uint32_t newJob) {
+            partialSequence = &jobs;
+            job = newJob;
+            if (workers.empty() || (jobs.size() + 1) * nbMachines < MIN_PARALLEL_WORK) {
+                computeHeads();
+                computeTails();
+                return bestPosition(0, jobs.size() + 1);
+            }
+            phaseBarrier.arrive_and_wait();
+            runPhases(0);
+            std::pair<double,size_t> best = bestByThread[0];
+            for (unsigned int thread = 1; thread < nbThreads; ++thread)
+                if (bestByThread[thread].first < best.first) best = bestByThread[thread];
+            return best;
+        }
+    };
+}
+
+FlowShopSolver::FlowShopSolver(FlowShopInstance *instance, unsigned int nbThreads) : instance(instance), nbThreads(std::max(1u, nbThreads)) {}
+
+void FlowShopSolver::solve() {
+    auto start = std::chrono::steady_clock::now();
+    CDS();
+    auto endSolve = std::chrono::steady_clock::now();
+    time_elapsed_CDS = std::chrono::duration<double>{endSolve - start};
+    start = std::chrono::steady_clock::now();
+    NEH();
+    endSolve = std::chrono::steady_clock::now();
+    time_elapsed_NEH = std::chrono::duration<double>{endSolve - start};
+}
+
+void FlowShopSolver::CDS() {
+    TRACE_SCOPE("FlowShopSolver::CDS");
+    objectiveCDS = std::numeric_limits<double>::infinity();
+    sequenceCDS.clear();
+    for (unsigned int k = 1; k < instance->getNbMachines(); ++k) {
+        Instance twoMachineInstance;
+        instance->buildCDSInstance(k, twoMachineInstance);
+        Solver solver(&twoMachineInstance, false);
+        solver.setEngine(PERMUTATION);
+        solver.solve();
+        double cmax = evaluate(solver.getPermutation());
+        if (cmax < objectiveCDS) {
+            objectiveCDS = cmax;
+            sequenceCDS = solver.getPermutation();
+        }
+    }
+}
+
+void FlowShopSolver::NEH() {
+    TRACE_SCOPE("FlowShopSolver::NEH");
+    sequence.clear();
+    if (sequenceCDS.empty()) {
+        objective = 0.0;
+        return;
+    }
+    sequence.reserve(sequenceCDS.size());
+    sequence.push_back(sequenceCDS.front());
+    objective = evaluate(sequence);
+    TaillardInsertion insertion(*instance, nbThreads);
+    for (size_t indexJob = 1; indexJob < sequenceCDS.size(); ++indexJob) {
+        auto [cmax, position] = insertion.insert(sequence, sequenceCDS[indexJob]);
+        sequence.insert(sequence.begin() + static_cast<long>(position), sequenceCDS[indexJob]);
+        objective = cmax;
+    }
+}
+
+double FlowShopSolver::evaluate(std::span<const uint32_t> sequenceToEvaluate) const {
+    std::vector<double> completions(instance->getNbMachines(), 0.0);
+    for (uint32_t job : sequenceToEvaluate) {
+        auto processingTimes = instance->getJob(job);
+        double completion = 0.0;
+        for (size_t machine = 0; machine < completions.size(); ++machine) {
+            completion = std::max(completion, completions[machine]) + processingTimes[machine];
+            completions[machine] = completion;
+        }
+    }
+    return completions.back();
+}
+
+void FlowShopSolver::printOutput(std::string &fileOutputName, std::ofstream &outputFile) {
+    bool fileExists = std::filesystem::exists(fileOutputName);
+    auto filePath = std::filesystem::path(fileOutputName);
+    std::filesystem::create_directories(filePath.lexically_normal().parent_path());
+    outputFile.open(fileOutputName, std::ios::out | std::ios::app | std::ios::ate);
+    // print header
+    if (!fileExists) {
+        outputFile << "InstanceName"
+                   << "\t" << "InstancePath"
+                   << "\t" << "n"
+                   << "\t" << "m"
+                   << "\t" << "pmax"
+                   << "\t" << "Threads"
+                   << "\t" << "TimeCDS"
+                   << "\t" << "ObjectiveCDS"
+                   << "\t" << "TimeNEH"
+                   << "\t" << "ObjectiveNEH" << std::endl;
+    }
+    // write value
+    outputFile << instance->getInstanceName()
+               << "\t" << instance->getInstancePath().string()
+               << "\t" << instance->getNbJobs()
+               << "\t" << instance->getNbMachines()
+               << "\t" << instance->getSupPj()
+               << "\t" << nbThreads
+               << "\t" << time_elapsed_CDS.count()
+               << "\t" << objectiveCDS
+               << "\t" << time_elapsed_NEH.count()
+               << "\t" << objective << std::endl;
+    outputFile.close();
+}
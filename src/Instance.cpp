@@ -35,6 +35,29 @@ Instance::Instance(std::string& newInstancePath) {
     setSeed(rd());
 }
 
+void Instance::reset() {
+    listJobs.clear();
+    fileOrder = true;
+    nbJobs = 0;
+    supPj = 100.0;
+    nbJobsA = 0;
+    nbJobsB = 0;
+    machinesSwapped = false;
+    splitWhileReading = false;
+    p_max_A = 0.0;
+    p_max_B = 0.0;
+    p_max = 0.0;
+    sumPA1 = 0.0;
+    sumPA2 = 0.0;
+    sumPB1 = 0.0;
+    sumPB2 = 0.0;
+}
+
+void Instance::reset(const std::string &newInstancePath) {
+    reset();
+    setInstancePath(newInstancePath);
+}
+
 Instance::Job Instance::generateJob(unsigned int infPi, unsigned int supPi) {
     double pj1,pj2;
     switch (distribution) {
@@ -96,28 +119,29 @@ Instance::Job Instance::generateJob(unsigned int infPi, unsigned int supPi) {
     return {pj1,pj2};
 }
 
+void Instance::setDistribution(const std::string &distributionName) {
+    if (distributionName == "uniform"){
+        distribution = UNIFORM;
+    }else if (distributionName == "negative_binomial") {
+        distribution = NEGATIVE_BINOMIAL;
+    }else if (distributionName == "geometric") {
+        distribution=GEOMETRIC;
+    }else if (distributionName == "poisson") {
+        distribution=POISSON;
+    }else if (distributionName == "exponential") {
+        distribution=EXPONENTIAL;
+    }else if (distributionName == "gamma") {
+        distribution=GAMMA;
+    }else if (distributionName == "weibull") {
+        distribution=WEIBULL;
+    }else if (distributionName == "lognormal") {
+        distribution=LOGNORMAL;
+    }else throw F2CmaxException("The distribution law is not implemented");
+}
+
 void Instance::generateInstance(nlohmann::json& paramInstance) {
-    if (paramInstance["paramInstance"].contains("distribution")) {
-        if (paramInstance["paramInstance"]["distribution"].is_string()) {
-            auto distributionName = paramInstance["paramInstance"]["distribution"].get<std::string>();
-            if (distributionName == "uniform"){
-                distribution = UNIFORM;
-            }else if (distributionName == "negative_binomial") {
-                distribution = NEGATIVE_BINOMIAL;
-            }else if (distributionName == "geometric") {
-                distribution=GEOMETRIC;
-            }else if (distributionName == "poisson") {
-                distribution=POISSON;
-            }else if (distributionName == "exponential") {
-                distribution=EXPONENTIAL;
-            }else if (distributionName == "gamma") {
-                distribution=GAMMA;
-            }else if (distributionName == "weibull") {
-                distribution=WEIBULL;
-            }else if (distributionName == "lognormal") {
-                distribution=LOGNORMAL;
-            }else throw F2CmaxException("The distribution law is not implemented");
-        }
+    if (paramInstance.contains("distribution")) {
+        if (paramInstance["distribution"].is_string()) setDistribution(paramInstance["distribution"].get<std::string>());
         else throw std::invalid_argument(R"(The "distribution" must be an string object)");
     }
     // set the number of N jobs
@@ -144,6 +168,11 @@ void Instance::generateInstance(nlohmann::json& paramInstance) {
     // generate Jobs
     listJobs.reserve(nbJobs);
     listJobs.clear();
+    fileOrder = true;
+    nbJobsA = 0;
+    nbJobsB = 0;
+    machinesSwapped = false;
+    splitWhileReading = false;
     for (unsigned int i = 0; i < nbJobs; ++i) {
         auto newJob = generateJob(infPi, supPi);
         addJob(newJob.first,newJob.second);
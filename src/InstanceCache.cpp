@@ -0,0 +1,68 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "InstanceCache.h"
+#include "Trace.h"
+
+const Instance &InstanceCache::get(std::string &filePath, const Parser &parser, unsigned int parserThreads, bool splitWhileParsing) {
+    TRACE_SCOPE("InstanceCache::get");
+    std::string key = std::filesystem::path(filePath).lexically_normal().string();
+    auto lastWriteTime = std::filesystem::last_write_time(key);
+    // only the parallel parser splits the jobs, the split instance has its own entry (a path has no null character)
+    splitWhileParsing = splitWhileParsing && parserThreads > 1;
+    if (splitWhileParsing) key.push_back('\0');
+    ++nbUses;
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second.lastWriteTime == lastWriteTime) {
+        ++nbHits;
+        it->second.lastUse = nbUses;
+        return it->second.instance;
+    }
+
+    ++nbMisses;
+    if (it == entries.end()) it = entries.try_emplace(key).first;
+    else nbBytes -= getNbBytes(it->second.instance);
+    Entry &entry = it->second;
+    try {
+        if (parserThreads > 1) parser.readFromFileParallel(filePath, entry.instance, parserThreads, splitWhileParsing);
+        else parser.readFromFile(filePath, entry.instance);
+    } catch (...) {
+        // an instance partially parsed is not kept
+        entries.erase(it);
+        throw;
+    }
+    entry.lastWriteTime = lastWriteTime;
+    entry.lastUse = nbUses;
+    nbBytes += getNbBytes(entry.instance);
+
+    // drop the least recently used instances, except the one returned
+    while (nbBytes > capacity && entries.size() > 1) {
+        auto leastRecentlyUsed = entries.end();
+        for (auto other = entries.begin(); other != entries.end(); ++other)
+            if (other != it && (leastRecentlyUsed == entries.end() || other->second.lastUse < leastRecentlyUsed->second.lastUse))
+                leastRecentlyUsed = other;
+        nbBytes -= getNbBytes(leastRecentlyUsed->second.instance);
+        entries.erase(leastRecentlyUsed);
+    }
+    return entry.instance;
+}
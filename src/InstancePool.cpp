@@ -0,0 +1,51 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "InstancePool.h"
+
+InstancePool::Lease &InstancePool::Lease::operator=(Lease &&other) noexcept {
+    if (this != &other) {
+        if (pool != nullptr && instance) pool->release(std::move(instance));
+        pool = other.pool;
+        instance = std::move(other.instance);
+    }
+    return *this;
+}
+
+InstancePool::Lease::~Lease() {
+    if (pool != nullptr && instance) pool->release(std::move(instance));
+}
+
+InstancePool::Lease InstancePool::acquire() {
+    if (freeInstances.empty()) {
+        ++nbCreated;
+        return {this, std::make_unique<Instance>()};
+    }
+    std::unique_ptr<Instance> instance = std::move(freeInstances.back());
+    freeInstances.pop_back();
+    return {this, std::move(instance)};
+}
+
+void InstancePool::release(std::unique_ptr<Instance> instance) {
+    freeInstances.push_back(std::move(instance));
+}
@@ -0,0 +1,197 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#include "JobAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <fstream>
+#include <iostream>
+#include <linux/mempolicy.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "MemoryTracker.h"
+
+HUGE_PAGES AllocationPolicy::hugePages = NO_HUGE_PAGES;
+NUMA_POLICY AllocationPolicy::numa = NO_NUMA;
+unsigned int AllocationPolicy::nbTouchThreads = std::max(1u, std::thread::hardware_concurrency());
+
+namespace {
+    constexpr size_t PAGE_SIZE = 4096;
+
+    size_t getMappedBytes(size_t bytes) {
+        return (bytes + AllocationPolicy::MIN_MAPPED_BYTES - 1) / AllocationPolicy::MIN_MAPPED_BYTES * AllocationPolicy::MIN_MAPPED_BYTES;
+    }
+
+    /**
+     * Mask of the online NUMA nodes, read from "/sys/devices/system/node/online" (for example "0-1,4").
+     */
+    unsigned long getOnlineNodes() {
+        std::ifstream fileStream("/sys/devices/system/node/online");
+        std::string ranges;
+        if (!(fileStream >> ranges)) return 1UL;
+        unsigned long mask = 0;
+        size_t pos = 0;
+        while (pos < ranges.size()) {
+            size_t end = ranges.find(',', pos);
+            if (end == std::string::npos) end = ranges.size();
+            auto range = ranges.substr(pos, end - pos);
+            auto dash = range.find('-');
+            unsigned long first = std::stoul(range.substr(0, dash));
+            unsigned long last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+            for (unsigned long node = first; node <= last && node < 8 * sizeof(mask); ++node) mask |= 1UL << node;
+            pos = end + 1;
+        }
+        return mask != 0 ? mask : 1UL;
+    }
+
+    void interleave(void *pointer, size_t bytes) {
+        static const unsigned long onlineNodes = getOnlineNodes();
+        // without NUMA support in the kernel, the pages are placed by the default policy
+        syscall(SYS_mbind, pointer, bytes, MPOL_INTERLEAVE, &onlineNodes, 8 * sizeof(onlineNodes), 0);
+    }
+
+    /**
+     * Team of threads faulting in the pages of the arrays with the first-touch policy, each one touching a contiguous
+     * slice. The calling thread is the thread 0 of the team, the other ones wait for the next array on a barrier.
+     */
+    class TouchTeam {
+        unsigned int nbThreads;
+        std::vector<std::thread> workers;
+        std::barrier<> phaseBarrier;
+        std::atomic<bool> stop{false};
+        volatile char *pages = nullptr;
+        size_t nbPages = 0;
+
+        void touch(unsigned int indexThread) const {
+            for (size_t page = nbPages * indexThread / nbThreads; page < nbPages * (indexThread + 1) / nbThreads; ++page)
+                pages[page * PAGE_SIZE] = 0;
+        }
+
+    public:
+        explicit TouchTeam(unsigned int nbThreads) : nbThreads(nbThreads), phaseBarrier(nbThreads) {
+            for (unsigned int indexThread = 1; indexThread < nbThreads; ++indexThread) {
+                workers.emplace_back([this, indexThread]() {
+                    while (true) {
+                        phaseBarrier.arrive_and_wait();
+                        if (stop.load()) return;
+                        touch(indexThread);
+                        phaseBarrier.arrive_and_wait();
+                    }
+                });
+            }
+        }
+
+        ~TouchTeam() {
+            stop.store(true);
+            phaseBarrier.arrive_and_wait();
+            for (auto &worker : workers) worker.join();
+        }
+
+        TouchTeam(const TouchTeam &) = delete;
+
+        TouchTeam &operator=(const TouchTeam &) = delete;
+
+        [[nodiscard]] unsigned int getNbThreads() const { return nbThreads; }
+
+        void touchPages(void *pointer, size_t bytes) {
+            pages = static_cast<volatile char *>(pointer);
+            nbPages = bytes / PAGE_SIZE;
+            phaseBarrier.arrive_and_wait();
+            touch(0);
+            phaseBarrier.arrive_and_wait();
+        }
+    };
+
+    void touchInParallel(void *pointer, size_t bytes, unsigned int nbThreads) {
+        if (nbThreads <= 1) {
+            auto *pages = static_cast<volatile char *>(pointer);
+            for (size_t page = 0; page < bytes / PAGE_SIZE; ++page) pages[page * PAGE_SIZE] = 0;
+            return;
+        }
+        // the team is created by the first array and kept until the end of the process, with its threads waiting for
+        // the next arrays, so that each array (for example each growth of a list of jobs) does not create threads.
+        // The arrays are touched one at a time.
+        static std::mutex teamMutex;
+        static std::unique_ptr<TouchTeam> team;
+        std::lock_guard lock(teamMutex);
+        if (team == nullptr || team->getNbThreads() != nbThreads) {
+            // the threads of the previous team, with another number of threads, are stopped and joined first
+            team.reset();
+            team = std::make_unique<TouchTeam>(nbThreads);
+        }
+        team->touchPages(pointer, bytes);
+    }
+}
+
+void *AllocationPolicy::allocate(size_t bytes) {
+    if (bytes < MIN_MAPPED_BYTES) return ::operator new(bytes);
+    size_t mappedBytes = getMappedBytes(bytes);
+    void *pointer = MAP_FAILED;
+    if (hugePages == EXPLICIT_HUGE_PAGES) {
+        pointer = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        static std::atomic<bool> warned{false};
+        if (pointer == MAP_FAILED && !warned.exchange(true))
+            std::cerr << "The explicit huge pages are not available (see /proc/sys/vm/nr_hugepages), transparent huge pages are used" << std::endl;
+    }
+    if (pointer == MAP_FAILED) {
+        pointer = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (pointer == MAP_FAILED) throw std::bad_alloc();
+        if (hugePages != NO_HUGE_PAGES) madvise(pointer, mappedBytes, MADV_HUGEPAGE);
+    }
+    if (numa == NUMA_INTERLEAVE) interleave(pointer, mappedBytes);
+    else if (numa == NUMA_FIRST_TOUCH) touchInParallel(pointer, mappedBytes, nbTouchThreads);
+    MemoryTracker::countMapping(mappedBytes);
+    return pointer;
+}
+
+void AllocationPolicy::deallocate(void *pointer, size_t bytes) noexcept {
+    if (bytes < MIN_MAPPED_BYTES) {
+        ::operator delete(pointer);
+        return;
+    }
+    size_t mappedBytes = getMappedBytes(bytes);
+    munmap(pointer, mappedBytes);
+    MemoryTracker::countUnmapping(mappedBytes);
+}
+
+std::string AllocationPolicy::getName() {
+    std::string name;
+    switch (hugePages) {
+        case NO_HUGE_PAGES: name = "default"; break;
+        case TRANSPARENT_HUGE_PAGES: name = "transparent"; break;
+        case EXPLICIT_HUGE_PAGES: name = "explicit"; break;
+    }
+    if (numa == NUMA_INTERLEAVE) name.append("+interleave");
+    else if (numa == NUMA_FIRST_TOUCH) name.append("+firstTouch");
+    return name;
+}
@@ -0,0 +1,180 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+
+namespace {
+    std::atomic<size_t> allocatedBytes{0};
+    std::atomic<size_t> nbAllocations{0};
+    std::atomic<size_t> liveBytes{0};
+    // the account of a thread is constant initialized, it can be used by operator new before any other initialization
+    thread_local MemoryTracker::Account threadAccount;
+    thread_local MemoryTracker::Account *attachedAccount = nullptr;
+    thread_local const MemoryTracker::Scope *innermostScope = nullptr;
+
+    inline MemoryTracker::Account &currentAccount() { return attachedAccount != nullptr ? *attachedAccount : threadAccount; }
+
+    inline void countBytes(size_t size) {
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        nbAllocations.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_add(size, std::memory_order_relaxed);
+        MemoryTracker::Account &account = currentAccount();
+        account.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        account.nbAllocations.fetch_add(1, std::memory_order_relaxed);
+        long live = account.liveBytes.fetch_add(static_cast<long>(size), std::memory_order_relaxed) + static_cast<long>(size);
+        long peak = account.peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !account.peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    }
+
+    inline void uncountBytes(size_t size) {
+        liveBytes.fetch_sub(size, std::memory_order_relaxed);
+        currentAccount().liveBytes.fetch_sub(static_cast<long>(size), std::memory_order_relaxed);
+    }
+
+    inline void *countAllocation(void *pointer) {
+        if (pointer == nullptr) return nullptr;
+        countBytes(malloc_usable_size(pointer));
+        return pointer;
+    }
+
+    inline void countDeallocation(void *pointer) {
+        if (pointer == nullptr) return;
+        uncountBytes(malloc_usable_size(pointer));
+        std::free(pointer);
+    }
+
+    void *allocate(size_t size) {
+        void *pointer = countAllocation(std::malloc(size != 0 ? size : 1));
+        if (pointer == nullptr) throw std::bad_alloc();
+        return pointer;
+    }
+
+    void *allocateAligned(size_t size, std::align_val_t alignment) {
+        auto align = static_cast<size_t>(alignment);
+        // the size of aligned_alloc must be a multiple of the alignment
+        void *pointer = countAllocation(std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align));
+        if (pointer == nullptr) throw std::bad_alloc();
+        return pointer;
+    }
+}
+
+/********************************************/
+/*      REPLACEMENT OF NEW AND DELETE       */
+/********************************************/
+
+void *operator new(size_t size) { return allocate(size); }
+
+void *operator new[](size_t size) { return allocate(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return countAllocation(std::malloc(size != 0 ? size : 1)); }
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return countAllocation(std::malloc(size != 0 ? size : 1)); }
+
+void *operator new(size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void *operator new[](size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void operator delete(void *pointer) noexcept { countDeallocation(pointer); }
+
+void operator delete[](void *pointer) noexcept { countDeallocation(pointer); }
+
+void operator delete(void *pointer, size_t) noexcept { countDeallocation(pointer); }
+
+void operator delete[](void *pointer, size_t) noexcept { countDeallocation(pointer); }
+
+void operator delete(void *pointer, std::align_val_t) noexcept { countDeallocation(pointer); }
+
+void operator delete[](void *pointer, std::align_val_t) noexcept { countDeallocation(pointer); }
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept { countDeallocation(pointer); }
+
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept { countDeallocation(pointer); }
+
+/********************/
+/*      TRACKER     */
+/********************/
+
+MemoryTracker::Scope::Scope(MemoryUsage &usage) : usage(usage), account(currentAccount()), outerScope(innermostScope) {
+    innermostScope = this;
+    startAllocatedBytes = account.allocatedBytes.load(std::memory_order_relaxed);
+    startNbAllocations = account.nbAllocations.load(std::memory_order_relaxed);
+    startLiveBytes = account.liveBytes.load(std::memory_order_relaxed);
+    outerPeakBytes = account.peakLiveBytes.exchange(startLiveBytes, std::memory_order_relaxed);
+}
+
+MemoryTracker::Scope::~Scope() {
+    // the scopes are nested on the thread which has constructed them
+    assert(innermostScope == this && &account == &currentAccount());
+    innermostScope = outerScope;
+    usage.allocatedBytes += account.allocatedBytes.load(std::memory_order_relaxed) - startAllocatedBytes;
+    usage.nbAllocations += account.nbAllocations.load(std::memory_order_relaxed) - startNbAllocations;
+    long peak = account.peakLiveBytes.load(std::memory_order_relaxed);
+    usage.peakBytes = std::max(usage.peakBytes, peak > startLiveBytes ? static_cast<size_t>(peak - startLiveBytes) : 0);
+    account.peakLiveBytes.store(std::max(outerPeakBytes, peak), std::memory_order_relaxed);
+}
+
+MemoryTracker::Attach::Attach(Account &account) : previousAccount(attachedAccount) {
+    // attaching a thread to its own account does nothing
+    if (&account != &threadAccount) attachedAccount = &account;
+}
+
+MemoryTracker::Attach::~Attach() { attachedAccount = previousAccount; }
+
+MemoryTracker::Account &MemoryTracker::getAccount() { return currentAccount(); }
+
+size_t MemoryTracker::getAllocatedBytes() { return allocatedBytes.load(std::memory_order_relaxed); }
+
+size_t MemoryTracker::getNbAllocations() { return nbAllocations.load(std::memory_order_relaxed); }
+
+size_t MemoryTracker::getLiveBytes() { return liveBytes.load(std::memory_order_relaxed); }
+
+void MemoryTracker::countMapping(size_t bytes) { countBytes(bytes); }
+
+void MemoryTracker::countUnmapping(size_t bytes) { uncountBytes(bytes); }
+
+size_t MemoryTracker::getPeakRSS() {
+    // VmHWM is reset by resetPeakRSS, ru_maxrss is not always
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmHWM:", 0) == 0) return std::stoul(line.substr(6)) * 1024; // in kB
+    }
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<size_t>(usage.ru_maxrss) * 1024; // in kilobytes on Linux
+}
+
+void MemoryTracker::resetPeakRSS() {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs.is_open()) clearRefs << "5" << std::flush;
+}
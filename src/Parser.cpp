@@ -22,11 +22,85 @@
 //
 
 #include "Parser.h"
+#include "MemoryTracker.h"
+#include "ParallelPartition.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    // smallest part of a file parsed by one thread, in bytes
+    constexpr size_t MIN_CHUNK_SIZE = 1UL << 20;
+
+    /**
+     * Parses the line [begin,end) of a job, without its end of line.
+     * @return false if the line is blank
+     */
+    bool parseJobLine(const char *begin, const char *end, double &pi1, double &pi2) {
+        double *pj[2] = {&pi1, &pi2};
+        for (auto pij : pj) {
+            while (begin != end && (*begin == ' ' || *begin == '\t')) ++begin;
+            auto [next, error] = std::from_chars(begin, end, *pij);
+            if (error != std::errc()) {
+                if (pij == &pi1 && begin == end) return false;
+                throw std::invalid_argument(std::string("The job line \"").append(begin, end).append("\" is not valid"));
+            }
+            begin = next;
+        }
+        return true;
+    }
+
+    /**
+     * Reads the attribute line [begin,end) "attribute:value" of an instance, colon is the position of ':'.
+     * @return true if the attribute is the number of jobs "n"
+     */
+    bool parseAttributeLine(const char *begin, const char *colon, const char *end, Instance &instance) {
+        std::string attribute(begin, colon);
+        std::string value(colon + 1, end);
+        if (attribute == "name") instance.setInstanceName(value);
+        else if (attribute == "n") {
+            instance.setNbJobs(std::stoul(value));
+            return true;
+        }
+        else if (attribute == "m" && std::stoul(value) != 2)
+            throw std::invalid_argument("The instance has more than two machines, it must be solved with \"flowShop\"");
+        return false;
+    }
+
+    /**
+     * Chunk of jobs parsed by one thread in its part of the list of jobs. If the jobs are split, the set A is at the
+     * beginning of the part and the set B after it with its processing times swapped, otherwise the jobs are in the order
+     * of the file.
+     */
+    struct ParsedChunk {
+        size_t nbJobs = 0;
+        size_t nbJobsA = 0;
+        Instance::SplitSums sums;
+        std::exception_ptr error;
+    };
+}
 
 Parser::Parser() {}
 
 Instance Parser::readFromFile(std::string &filePath) const {
-    Instance newInstance = Instance(filePath);
+    Instance newInstance;
+    readFromFile(filePath, newInstance);
+    return newInstance;
+}
+
+void Parser::readFromFile(std::string &filePath, Instance &newInstance) const {
+    TRACE_SCOPE("Parser::readFromFile");
+    newInstance.reset(filePath);
     std::fstream fileStream(newInstance.getInstancePath().lexically_normal(), std::fstream::in);
     std::string line; // new line
     // open and read the file
@@ -46,6 +120,8 @@ Instance Parser::readFromFile(std::string &filePath) const {
                 std::string attribute = line.substr(0, pos);
                 if (attribute == "name") newInstance.setInstanceName(line.substr(pos + 1));
                 else if (attribute == "n") newInstance.setNbJobs(std::stoul(line.substr(pos + 1)));
+                else if (attribute == "m" && std::stoul(line.substr(pos + 1)) != 2)
+                    throw std::invalid_argument("The instance has more than two machines, it must be solved with \"flowShop\"");
             }
         }
     } else
@@ -55,7 +131,200 @@ Instance Parser::readFromFile(std::string &filePath) const {
     // check if we have the right number of created job
     if (newInstance.getNbJobs() != newInstance.getListJobs().size())
         throw std::invalid_argument("The number of jobs is not equals to n");
-    return newInstance;
+}
+
+void Parser::readFromFileDescriptor(int fileDescriptor, Instance &newInstance, bool splitWhileReading) const {
+    TRACE_SCOPE("Parser::readFromFileDescriptor");
+    newInstance.reset();
+    newInstance.setStreamPath(fileDescriptor == 0 ? std::string("stdin") : std::string("fd").append(std::to_string(fileDescriptor)));
+    bool nbJobsGiven = false;
+    size_t nbJobsRead = 0;
+
+    // parse one line [begin,end) without its '\n'
+    auto parseLine = [&](const char *begin, const char *end) {
+        if (begin != end && end[-1] == '\r') --end;
+        auto colon = static_cast<const char *>(std::memchr(begin, ':', end - begin));
+        double pi1, pi2;
+        if (colon != nullptr) nbJobsGiven |= parseAttributeLine(begin, colon, end, newInstance);
+        else if (parseJobLine(begin, end, pi1, pi2)) {
+            if (splitWhileReading) newInstance.addJobSplitRevisitedJohnson(pi1, pi2);
+            else newInstance.addJob(pi1, pi2);
+            ++nbJobsRead;
+        }
+    };
+
+    // the chunk keeps at its beginning the last line of the previous read, which may be incomplete
+    std::vector<char> chunk(1UL << 20);
+    size_t nbPending = 0;
+    while (true) {
+        ssize_t nbRead = ::read(fileDescriptor, chunk.data() + nbPending, chunk.size() - nbPending);
+        if (nbRead < 0) {
+            if (errno == EINTR) continue;
+            throw F2CmaxException(std::string("Can't read the stream ").append(newInstance.getInstanceName()).append(": ").append(std::strerror(errno)).c_str());
+        }
+        const char *begin = chunk.data();
+        const char *end = chunk.data() + nbPending + nbRead;
+        const char *newLine;
+        while ((newLine = static_cast<const char *>(std::memchr(begin, '\n', end - begin))) != nullptr) {
+            parseLine(begin, newLine);
+            begin = newLine + 1;
+        }
+        nbPending = end - begin;
+        if (nbRead == 0) {
+            // the last line may have no '\n'
+            if (nbPending != 0) parseLine(begin, end);
+            break;
+        }
+        std::memmove(chunk.data(), begin, nbPending);
+        if (nbPending == chunk.size()) chunk.resize(2 * chunk.size()); // line longer than the chunk
+    }
+
+    // check if we have the right number of created job
+    if (!nbJobsGiven) newInstance.setNbJobs(nbJobsRead);
+    else if (newInstance.getNbJobs() != nbJobsRead)
+        throw std::invalid_argument("The number of jobs is not equals to n");
+}
+
+void Parser::readFromFileParallel(std::string &filePath, Instance &newInstance, unsigned int nbThreads, bool splitWhileReading) const {
+    TRACE_SCOPE("Parser::readFromFileParallel");
+    newInstance.reset(filePath);
+    std::string fileName = newInstance.getInstancePath().lexically_normal().string();
+    int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) throw F2CmaxException(std::string("Can't open the file ").append(fileName).c_str());
+    struct stat fileStat{};
+    if (::fstat(fileDescriptor, &fileStat) != 0) {
+        ::close(fileDescriptor);
+        throw F2CmaxException(std::string("Can't read the size of the file ").append(fileName).c_str());
+    }
+    auto fileSize = static_cast<size_t>(fileStat.st_size);
+    const char *data = "";
+    if (fileSize > 0) {
+        void *mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fileDescriptor);
+            throw F2CmaxException(std::string("Can't map the file ").append(fileName).c_str());
+        }
+        ::madvise(mapping, fileSize, MADV_SEQUENTIAL);
+        data = static_cast<const char *>(mapping);
+    }
+    ::close(fileDescriptor);
+    // the file is unmapped when the method returns or throws
+    auto unmap = [fileSize](const char *mapping) { ::munmap(const_cast<char *>(mapping), fileSize); };
+    std::unique_ptr<const char, decltype(unmap)> mapping(fileSize > 0 ? data : nullptr, unmap);
+    const char *end = data + fileSize;
+
+    // the attributes are the lines with ':' before the first job
+    const char *jobs = data;
+    bool nbJobsGiven = false;
+    while (jobs != end) {
+        auto newLine = static_cast<const char *>(std::memchr(jobs, '\n', end - jobs));
+        const char *lineEnd = newLine != nullptr ? newLine : end;
+        auto colon = static_cast<const char *>(std::memchr(jobs, ':', lineEnd - jobs));
+        if (colon == nullptr) break;
+        if (lineEnd != jobs && lineEnd[-1] == '\r') --lineEnd;
+        nbJobsGiven |= parseAttributeLine(jobs, colon, lineEnd, newInstance);
+        jobs = newLine != nullptr ? newLine + 1 : end;
+    }
+
+    // the jobs are cut in chunks at the beginning of a line, each chunk is parsed by one thread
+    size_t nbChunks = std::clamp<size_t>((end - jobs) / MIN_CHUNK_SIZE, 1, std::max(nbThreads, 1U));
+    std::vector<const char *> chunkBounds(nbChunks + 1, end);
+    chunkBounds[0] = jobs;
+    for (size_t chunk = 1; chunk < nbChunks; ++chunk) {
+        const char *bound = std::max(chunkBounds[chunk - 1], jobs + (end - jobs) * chunk / nbChunks);
+        auto newLine = static_cast<const char *>(std::memchr(bound, '\n', end - bound));
+        chunkBounds[chunk] = newLine != nullptr ? newLine + 1 : end;
+    }
+    std::vector<ParsedChunk> chunks(nbChunks);
+    // the allocations of the threads are counted in the account of the calling thread
+    MemoryTracker::Account &account = MemoryTracker::getAccount();
+    auto runOnChunks = [&chunks, &account](auto &&task) {
+        std::vector<std::thread> threads;
+        threads.reserve(chunks.size() - 1);
+        auto runTask = [&chunks, &task, &account](size_t chunk) {
+            MemoryTracker::Attach attach(account);
+            try { task(chunk); }
+            catch (...) { chunks[chunk].error = std::current_exception(); }
+        };
+        for (size_t chunk = 1; chunk < chunks.size(); ++chunk) threads.emplace_back(runTask, chunk);
+        runTask(0);
+        for (auto &thread : threads) thread.join();
+        for (auto &parsedChunk : chunks) if (parsedChunk.error) std::rethrow_exception(parsedChunk.error);
+    };
+    // calls lineTask on each line of a chunk, without its end of line
+    auto forEachLine = [&chunkBounds](size_t chunk, auto &&lineTask) {
+        const char *line = chunkBounds[chunk];
+        const char *chunkEnd = chunkBounds[chunk + 1];
+        while (line != chunkEnd) {
+            auto newLine = static_cast<const char *>(std::memchr(line, '\n', chunkEnd - line));
+            const char *lineEnd = newLine != nullptr ? newLine : chunkEnd;
+            const char *next = newLine != nullptr ? newLine + 1 : chunkEnd;
+            if (lineEnd != line && lineEnd[-1] == '\r') --lineEnd;
+            lineTask(line, lineEnd);
+            line = next;
+        }
+    };
+
+    // first pass: the jobs of each chunk are counted, so that each one is parsed in place in its part of the list
+    runOnChunks([&](size_t chunk) {
+        TRACE_SCOPE("Parser::countChunk");
+        size_t nbJobsChunk = 0;
+        forEachLine(chunk, [&nbJobsChunk](const char *line, const char *lineEnd) {
+            nbJobsChunk += std::find_if(line, lineEnd, [](char c) { return c != ' ' && c != '\t'; }) != lineEnd;
+        });
+        chunks[chunk].nbJobs = nbJobsChunk;
+    });
+    std::vector<size_t> offsets(nbChunks + 1, 0);
+    for (size_t chunk = 0; chunk < nbChunks; ++chunk) offsets[chunk + 1] = offsets[chunk] + chunks[chunk].nbJobs;
+    size_t nbJobsRead = offsets[nbChunks];
+    // check if we have the right number of created job
+    if (!nbJobsGiven) newInstance.setNbJobs(nbJobsRead);
+    else if (newInstance.getNbJobs() != nbJobsRead)
+        throw std::invalid_argument("The number of jobs is not equals to n");
+    auto listJobs = newInstance.resizeListJobs(nbJobsRead);
+
+    // second pass: each chunk is parsed in its part of the list. If the jobs are split, the jobs of A are put at the
+    // beginning of the part and the jobs of B after them with their processing times swapped
+    runOnChunks([&](size_t chunk) {
+        TRACE_SCOPE("Parser::parseChunk");
+        ParsedChunk &parsedChunk = chunks[chunk];
+        auto &sums = parsedChunk.sums;
+        auto part = listJobs.subspan(offsets[chunk], parsedChunk.nbJobs);
+        size_t nbParsed = 0;
+        forEachLine(chunk, [&](const char *line, const char *lineEnd) {
+            if (std::memchr(line, ':', lineEnd - line) != nullptr)
+                throw std::invalid_argument("The attributes of the instance must be before its jobs");
+            double pi1, pi2;
+            if (!parseJobLine(line, lineEnd, pi1, pi2)) return;
+            if (!splitWhileReading) part[nbParsed++] = {pi1, pi2};
+            else {
+                sums.p_max = std::max(sums.p_max, std::max(pi1, pi2));
+                if (pi1 < pi2) {
+                    part[nbParsed++] = part[parsedChunk.nbJobsA];
+                    part[parsedChunk.nbJobsA++] = {pi1, pi2};
+                    sums.p_max_A = std::max(sums.p_max_A, pi1);
+                    sums.sumPA1 += pi1;
+                    sums.sumPA2 += pi2;
+                } else {
+                    part[nbParsed++] = {pi2, pi1};
+                    sums.p_max_B = std::max(sums.p_max_B, pi2);
+                    sums.sumPB1 += pi2;
+                    sums.sumPB2 += pi1;
+                }
+            }
+        });
+    });
+    if (!splitWhileReading) return;
+
+    // the parts are joined: the jobs of B before the end of A are swapped with the jobs of A after it
+    std::vector<size_t> nbJobsAByChunk(nbChunks);
+    Instance::SplitSums sums;
+    for (size_t chunk = 0; chunk < nbChunks; ++chunk) {
+        nbJobsAByChunk[chunk] = chunks[chunk].nbJobsA;
+        sums.merge(chunks[chunk].sums);
+    }
+    auto endA = ParallelPartition::joinBlocks(listJobs.begin(), offsets, nbJobsAByChunk);
+    newInstance.setSplitWhileReading(static_cast<size_t>(endA - listJobs.begin()), sums);
 }
 
 void Parser::serializeInstance(Instance &instance) {
@@ -70,7 +339,59 @@ void Parser::serializeInstance(Instance &instance) {
     fileStream.close();
 }
 
+FlowShopInstance Parser::readFlowShopFromFile(std::string &filePath) const {
+    TRACE_SCOPE("Parser::readFlowShopFromFile");
+    FlowShopInstance newInstance(filePath);
+    std::fstream fileStream(newInstance.getInstancePath().lexically_normal(), std::fstream::in);
+    std::string line; // new line
+    std::vector<double> jobProcessingTimes;
+    // open and read the file
+    if (fileStream.is_open()) {
+        while (std::getline(fileStream, line)) {
+            auto pos = line.find(":");
+            // if we don't find the ':' then we read jobs
+            if (pos == std::string::npos) {
+                // create the job, the m values should be separate with \t
+                std::istringstream stream(line);
+                jobProcessingTimes.resize(newInstance.getNbMachines());
+                for (auto &pij : jobProcessingTimes) stream >> pij;
+                newInstance.addJob(jobProcessingTimes);
+            } else {
+                // we read so attributes
+                std::string attribute = line.substr(0, pos);
+                if (attribute == "name") newInstance.setInstanceName(line.substr(pos + 1));
+                else if (attribute == "n") newInstance.setNbJobs(std::stoul(line.substr(pos + 1)));
+                else if (attribute == "m") newInstance.setNbMachines(std::stoul(line.substr(pos + 1)));
+            }
+        }
+    } else
+        throw F2CmaxException(std::string("Can't open the file ").append(newInstance.getInstancePath().lexically_normal().string()).c_str());
+    fileStream.close();
+
+    // check if we have the right number of created job
+    if (newInstance.getNbJobs() != newInstance.getNbAddedJobs())
+        throw std::invalid_argument("The number of jobs is not equals to n");
+    return newInstance;
+}
+
+void Parser::serializeFlowShopInstance(FlowShopInstance &instance) {
+    std::fstream fileStream(instance.getInstancePath().lexically_normal().string(), std::fstream::out );
+    if (fileStream.is_open()) {
+        fileStream << std::setprecision(5) << "name:" << instance.getInstanceName() << std::endl
+                   << "m:" << instance.getNbMachines() << std::endl
+                   << "n:" << instance.getNbJobs() << std::endl << "Jobs:" << std::endl;
+        for (size_t job = 0; job < instance.getNbAddedJobs(); ++job) {
+            auto jobProcessingTimes = instance.getJob(job);
+            fileStream << jobProcessingTimes[0];
+            for (size_t machine = 1; machine < jobProcessingTimes.size(); ++machine) fileStream << "\t" << jobProcessingTimes[machine];
+            fileStream << std::endl;
+        }
+    } else throw F2CmaxException(std::string("Can't open the file ").append(instance.getInstancePath().lexically_normal().string()).c_str());
+    fileStream.close();
+}
+
 void Parser::generateInstance(nlohmann::json &object) {
+    TRACE_SCOPE("Parser::generateInstance");
 
     Instance newInstance;
 
@@ -112,15 +433,29 @@ void Parser::generateInstance(nlohmann::json &object) {
                 if (paramInstance["paramInstance"]["distribution"].is_string()) distribution = paramInstance["paramInstance"]["distribution"];
                 else throw std::invalid_argument(R"(The "distribution" must be an string object)");
             }
+            // the instances of more than two machines are for the permutation flow shop
+            unsigned int nbMachines = 2;
+            if (paramInstance["paramInstance"].contains("m")) {
+                if (paramInstance["paramInstance"]["m"].is_number_unsigned()) nbMachines = paramInstance["paramInstance"]["m"];
+                else throw std::invalid_argument(R"(The "m" must be an unsigned integer)");
+            }
 
             for (unsigned int newInstanceLoop = 0; newInstanceLoop < nbInstanceToGenerate; ++newInstanceLoop) {
                 std::string path = basePath;
                 path.append("instance")
                     .append(std::to_string(nbGeneratedInstance))
-                    .append("_n_").append(std::to_string(paramInstance["paramInstance"]["n"].template get<unsigned int>()))
-                    .append("_pmax_").append(std::to_string(maxP))
+                    .append("_n_").append(std::to_string(paramInstance["paramInstance"]["n"].template get<unsigned int>()));
+                if (nbMachines > 2) path.append("_m_").append(std::to_string(nbMachines));
+                path.append("_pmax_").append(std::to_string(maxP))
                     .append("_distribution_").append(distribution)
                     .append(".txt");
+                if (nbMachines > 2) {
+                    FlowShopInstance newFlowShopInstance(path);
+                    newFlowShopInstance.generateInstance(paramInstance["paramInstance"], newInstance);
+                    serializeFlowShopInstance(newFlowShopInstance);
+                    ++nbGeneratedInstance;
+                    continue;
+                }
                 newInstance.setInstancePath(path);
                 newInstance.generateInstance(paramInstance["paramInstance"]);
                 serializeInstance(newInstance);
@@ -0,0 +1,159 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "PermutationEvaluator.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t LANES = PermutationEvaluator::LANES;
+
+    // one value of each lane, the operations on this type are SIMD instructions (GCC vector extension)
+    typedef double LaneVector __attribute__((vector_size(LANES * sizeof(double))));
+}
+
+PermutationEvaluator::PermutationEvaluator(const FlowShopInstance *instance) : instance(instance), nbMachines(instance->getNbMachines()), segment(instance->getNbMachines()) {}
+
+void PermutationEvaluator::evaluateBatch(const uint32_t *sequences, size_t nbSequences, double *cmax) const {
+    size_t nbJobs = instance->getNbAddedJobs();
+    std::vector<LaneVector> completions(nbMachines);
+    std::array<const double*, LANES> jobRows{};
+    for (size_t firstSequence = 0; firstSequence < nbSequences; firstSequence += LANES) {
+        size_t nbLanes = std::min(LANES, nbSequences - firstSequence);
+        std::fill(completions.begin(), completions.end(), LaneVector{});
+        for (size_t position = 0; position < nbJobs; ++position) {
+            // processing times of the job at this position in each candidate, the empty lanes repeat the first one
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                size_t sequence = firstSequence + (lane < nbLanes ? lane : 0);
+                jobRows[lane] = instance->getJob(sequences[sequence * nbJobs + position]).data();
+            }
+            LaneVector completion{};
+            for (size_t machine = 0; machine < nbMachines; ++machine) {
+                LaneVector processingTimes;
+                for (size_t lane = 0; lane < LANES; ++lane) processingTimes[lane] = jobRows[lane][machine];
+                LaneVector previous = completions[machine];
+                completion = (completion > previous ? completion : previous) + processingTimes;
+                completions[machine] = completion;
+            }
+        }
+        for (size_t lane = 0; lane < nbLanes; ++lane) cmax[firstSequence + lane] = completions.back()[lane];
+    }
+}
+
+double PermutationEvaluator::setSequence(std::span<const uint32_t> newSequence) {
+    if (newSequence.size() != instance->getNbAddedJobs())
+        throw std::invalid_argument("The sequence must have all the jobs of the instance");
+    sequence.assign(newSequence.begin(), newSequence.end());
+    heads.assign((sequence.size() + 1) * nbMachines, 0.0);
+    tails.assign((sequence.size() + 1) * nbMachines, 0.0);
+    updateHeadsAndTails(0, sequence.size());
+    return getCmax();
+}
+
+void PermutationEvaluator::updateHeadsAndTails(size_t firstRow, size_t lastRow) {
+    for (size_t r = firstRow + 1; r <= sequence.size(); ++r) {
+        auto processingTimes = instance->getJob(sequence[r - 1]);
+        double *row = heads.data() + r * nbMachines;
+        const double *previousRow = row - nbMachines;
+        double completion = 0.0;
+        for (size_t l = 0; l < nbMachines; ++l) {
+            completion = std::max(completion, previousRow[l]) + processingTimes[l];
+            row[l] = completion;
+        }
+    }
+    for (size_t r = lastRow; r-- > 0;) {
+        auto processingTimes = instance->getJob(sequence[r]);
+        double *row = tails.data() + r * nbMachines;
+        const double *nextRow = row + nbMachines;
+        double tail = 0.0;
+        for (size_t l = nbMachines; l-- > 0;) {
+            tail = std::max(tail, nextRow[l]) + processingTimes[l];
+            row[l] = tail;
+        }
+    }
+}
+
+double PermutationEvaluator::evaluateMoveJobs(size_t r, size_t after) {
+    std::copy_n(heads.begin() + static_cast<long>(r * nbMachines), nbMachines, segment.begin());
+    for (uint32_t job : moveJobs) {
+        auto processingTimes = instance->getJob(job);
+        double completion = 0.0;
+        for (size_t l = 0; l < nbMachines; ++l) {
+            completion = std::max(completion, segment[l]) + processingTimes[l];
+            segment[l] = completion;
+        }
+    }
+    const double *tailRow = tails.data() + after * nbMachines;
+    double cmax = 0.0;
+    for (size_t l = 0; l < nbMachines; ++l) cmax = std::max(cmax, segment[l] + tailRow[l]);
+    return cmax;
+}
+
+std::pair<size_t,size_t> PermutationEvaluator::buildSwap(size_t first, size_t second) {
+    if (first >= sequence.size() || second >= sequence.size()) throw std::out_of_range("The position of the move is out of the sequence");
+    if (first > second) std::swap(first, second);
+    moveJobs.assign(sequence.begin() + static_cast<long>(first), sequence.begin() + static_cast<long>(second) + 1);
+    std::swap(moveJobs.front(), moveJobs.back());
+    return {first, second + 1};
+}
+
+std::pair<size_t,size_t> PermutationEvaluator::buildInsert(size_t from, size_t to) {
+    if (from >= sequence.size() || to >= sequence.size()) throw std::out_of_range("The position of the move is out of the sequence");
+    size_t first = std::min(from, to);
+    size_t last = std::max(from, to);
+    moveJobs.assign(sequence.begin() + static_cast<long>(first), sequence.begin() + static_cast<long>(last) + 1);
+    // the job moves to the front of the part if it goes backward, to the back otherwise
+    if (from > to) std::rotate(moveJobs.begin(), moveJobs.end() - 1, moveJobs.end());
+    else std::rotate(moveJobs.begin(), moveJobs.begin() + 1, moveJobs.end());
+    return {first, last + 1};
+}
+
+double PermutationEvaluator::evaluateSwap(size_t first, size_t second) {
+    if (first == second) return getCmax();
+    auto [r, after] = buildSwap(first, second);
+    return evaluateMoveJobs(r, after);
+}
+
+double PermutationEvaluator::evaluateInsert(size_t from, size_t to) {
+    if (from == to) return getCmax();
+    auto [r, after] = buildInsert(from, to);
+    return evaluateMoveJobs(r, after);
+}
+
+double PermutationEvaluator::applySwap(size_t first, size_t second) {
+    if (first == second) return getCmax();
+    auto [r, after] = buildSwap(first, second);
+    std::copy(moveJobs.begin(), moveJobs.end(), sequence.begin() + static_cast<long>(r));
+    updateHeadsAndTails(r, after);
+    return getCmax();
+}
+
+double PermutationEvaluator::applyInsert(size_t from, size_t to) {
+    if (from == to) return getCmax();
+    auto [r, after] = buildInsert(from, to);
+    std::copy(moveJobs.begin(), moveJobs.end(), sequence.begin() + static_cast<long>(r));
+    updateHeadsAndTails(r, after);
+    return getCmax();
+}
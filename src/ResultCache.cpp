@@ -0,0 +1,180 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "ResultCache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <unistd.h>
+#include <vector>
+
+#include "Solver.h"
+#include "Trace.h"
+
+namespace {
+    constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+    inline uint64_t rotateLeft(uint64_t value, int shift) { return (value << shift) | (value >> (64 - shift)); }
+
+    inline uint64_t mixWord(uint64_t lane, uint64_t word) { return rotateLeft(lane + word * PRIME_2, 31) * PRIME_1; }
+}
+
+ResultCache::ResultCache(const std::filesystem::path &cachePath) : cachePath(cachePath) {
+    if (!std::filesystem::exists(cachePath)) return;
+    std::ifstream fileStream(cachePath);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(cachePath.string()).c_str());
+    nlohmann::json cache = nlohmann::json::parse(fileStream);
+    if (!cache.is_object()) throw std::invalid_argument(std::string("The result cache must be a JSON object: ").append(cachePath.string()));
+    for (auto &[key, value] : cache.items()) {
+        Result result;
+        result.instanceName = value.at("name").get<std::string>();
+        result.nbJobs = value.at("n").get<unsigned int>();
+        result.supPj = value.at("pmax").get<double>();
+        result.engine = CostModel::getEngineFromName(value.at("engine").get<std::string>());
+        result.metrics = value.at("metrics").get<std::array<size_t,6>>();
+        // the results cached before the runs were measured have no runs
+        if (value.contains("runs")) result.runs = value.at("runs").get<std::array<size_t,2>>();
+        result.objective = value.at("objective").get<double>();
+        results.emplace(key, std::move(result));
+    }
+}
+
+uint64_t ResultCache::hashFile(const std::string &filePath) {
+    TRACE_SCOPE("ResultCache::hashFile");
+    int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) throw F2CmaxException(std::string("Can't open the file ").append(filePath).c_str());
+    std::vector<char> chunk(1UL << 20);
+    uint64_t lanes[4] = {PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1};
+    uint64_t nbBytes = 0;
+    uint64_t tail = 0; // the last bytes, fewer than 8, are hashed at the end
+    int nbTailBytes = 0;
+    while (true) {
+        // fill the chunk, so that only the last one is partial
+        size_t nbRead = 0;
+        while (nbRead < chunk.size()) {
+            ssize_t nbReadNow = ::read(fileDescriptor, chunk.data() + nbRead, chunk.size() - nbRead);
+            if (nbReadNow < 0) {
+                if (errno == EINTR) continue;
+                ::close(fileDescriptor);
+                throw F2CmaxException(std::string("Can't read the file ").append(filePath).append(": ").append(std::strerror(errno)).c_str());
+            }
+            if (nbReadNow == 0) break;
+            nbRead += nbReadNow;
+        }
+        nbBytes += nbRead;
+        size_t position = 0;
+        for (; position + 32 <= nbRead; position += 32) {
+            uint64_t words[4];
+            std::memcpy(words, chunk.data() + position, 32);
+            for (int lane = 0; lane < 4; ++lane) lanes[lane] = mixWord(lanes[lane], words[lane]);
+        }
+        for (; position + 8 <= nbRead; position += 8) {
+            uint64_t word;
+            std::memcpy(&word, chunk.data() + position, 8);
+            lanes[0] = mixWord(lanes[0], word);
+        }
+        for (; position < nbRead; ++position) tail |= static_cast<uint64_t>(static_cast<unsigned char>(chunk[position])) << (8 * nbTailBytes++);
+        if (nbRead < chunk.size()) break;
+    }
+    ::close(fileDescriptor);
+    uint64_t hash = rotateLeft(lanes[0], 1) + rotateLeft(lanes[1], 7) + rotateLeft(lanes[2], 12) + rotateLeft(lanes[3], 18);
+    hash = mixWord(hash, tail) ^ nbBytes;
+    // final avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+std::string ResultCache::getKey(uint64_t contentHash, ENGINE engine, bool useRevisited, const std::string &prefixSort) {
+    char hexHash[17];
+    std::snprintf(hexHash, sizeof(hexHash), "%016llx", static_cast<unsigned long long>(contentHash));
+    return std::string(hexHash).append("/").append(CostModel::getEngineName(engine))
+        .append(useRevisited ? "/revisited/" : "/johnson/").append(prefixSort);
+}
+
+const ResultCache::Result *ResultCache::find(const std::string &key) const {
+    auto it = results.find(key);
+    return it != results.end() ? &it->second : nullptr;
+}
+
+void ResultCache::insert(const std::string &key, const Result &result) {
+    results.insert_or_assign(key, result);
+    modified = true;
+}
+
+void ResultCache::save() {
+    TRACE_SCOPE("ResultCache::save");
+    if (!modified) return;
+    nlohmann::json cache = nlohmann::json::object();
+    for (auto &[key, result] : results) {
+        cache[key] = {
+            {"name", result.instanceName},
+            {"n", result.nbJobs},
+            {"pmax", result.supPj},
+            {"engine", CostModel::getEngineName(result.engine)},
+            {"metrics", result.metrics},
+            {"runs", result.runs},
+            {"objective", result.objective}
+        };
+    }
+    if (cachePath.has_parent_path()) std::filesystem::create_directories(cachePath.lexically_normal().parent_path());
+    // the cache is written in a temporary file first, so that an interrupted run does not corrupt it
+    auto tmpPath = std::filesystem::path(cachePath).concat(".tmp");
+    std::ofstream fileStream(tmpPath);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(tmpPath.string()).c_str());
+    fileStream << cache.dump() << std::endl;
+    fileStream.close();
+    std::filesystem::rename(tmpPath, cachePath);
+    modified = false;
+}
+
+void ResultCache::printOutput(const Result &result, const std::string &instancePath, bool useRevisited, const std::string &fileOutputName) {
+    bool fileExists = std::filesystem::exists(fileOutputName);
+    auto filePath = std::filesystem::path(fileOutputName);
+    std::filesystem::create_directories(filePath.lexically_normal().parent_path());
+    std::ofstream outputFile(fileOutputName, std::ios::out | std::ios::app | std::ios::ate);
+    if (!fileExists) Solver::printHeader(outputFile, useRevisited);
+    printRow(result, instancePath, useRevisited, outputFile);
+    outputFile.close();
+}
+
+void ResultCache::printRow(const Result &result, const std::string &instancePath, bool useRevisited, std::ostream &outputFile) {
+    outputFile << result.instanceName
+               << "\t" << instancePath
+               << "\t" << result.nbJobs
+               << "\t" << result.supPj
+               << "\t" << CostModel::getEngineName(result.engine);
+    // the times were not measured
+    for (int indexTime = 0; indexTime < (useRevisited ? 10 : 7); ++indexTime) outputFile << "\t" << 0;
+    for (auto metric : result.metrics) outputFile << "\t" << metric;
+    for (auto nbRuns : result.runs) outputFile << "\t" << nbRuns;
+    outputFile << "\t" << result.objective;
+    // nor the memory
+    for (int indexMemory = 0; indexMemory < 3 * NB_MEMORY_PHASES + 1; ++indexMemory) outputFile << "\t" << 0;
+    outputFile << "\t" << AllocationPolicy::getName() << std::endl;
+}
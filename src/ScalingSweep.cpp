@@ -0,0 +1,291 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#include "ScalingSweep.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <unistd.h>
+
+#include "Solver.h"
+#include "Trace.h"
+
+namespace {
+    double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+    }
+
+    /**
+     * Median and coefficient of variation of a list of ratios.
+     */
+    std::pair<double,double> medianAndSpread(const std::vector<double> &ratios) {
+        double mean = 0.0;
+        for (double ratio : ratios) mean += ratio;
+        mean /= static_cast<double>(ratios.size());
+        double variance = 0.0;
+        for (double ratio : ratios) variance += (ratio - mean) * (ratio - mean);
+        variance /= static_cast<double>(ratios.size());
+        return {median(ratios), mean > 0.0 ? std::sqrt(variance) / mean : 0.0};
+    }
+
+    std::string getHostName() {
+        char hostName[256] = {};
+        if (gethostname(hostName, sizeof(hostName) - 1) != 0) return "unknown";
+        return hostName;
+    }
+
+    std::string getPointKey(ENGINE engine, const std::string &distribution, unsigned int pmax, unsigned int n) {
+        return CostModel::getEngineName(engine).append("/").append(distribution).append("/")
+            .append(std::to_string(pmax)).append("/").append(std::to_string(n));
+    }
+}
+
+ScalingSweep::ScalingSweep(const nlohmann::json &paramSweep) {
+    if (!paramSweep.contains("output") || !paramSweep["output"].is_string())
+        throw std::invalid_argument(R"(The "sweep" object must have an "output" string)");
+    outputDir = paramSweep["output"].get<std::string>();
+    if (paramSweep.contains("seed")) {
+        if (paramSweep["seed"].is_number_unsigned()) seed = paramSweep["seed"];
+        else throw std::invalid_argument(R"(The "seed" must be an unsigned integer in the "sweep" object)");
+    }
+    if (paramSweep.contains("repetitions")) {
+        if (paramSweep["repetitions"].is_number_unsigned() && paramSweep["repetitions"] > 0) repetitions = paramSweep["repetitions"];
+        else throw std::invalid_argument(R"(The "repetitions" must be a positive integer in the "sweep" object)");
+    }
+    if (paramSweep.contains("n")) {
+        if (paramSweep["n"].is_array()) listN = paramSweep["n"].get<std::vector<unsigned int>>();
+        else throw std::invalid_argument(R"(The "n" must be an array of unsigned integers in the "sweep" object)");
+    }
+    if (paramSweep.contains("pmax")) {
+        if (paramSweep["pmax"].is_array()) listPMax = paramSweep["pmax"].get<std::vector<unsigned int>>();
+        else throw std::invalid_argument(R"(The "pmax" must be an array of unsigned integers in the "sweep" object)");
+    }
+    if (paramSweep.contains("distributions")) {
+        if (paramSweep["distributions"].is_array()) listDistributions = paramSweep["distributions"].get<std::vector<std::string>>();
+        else throw std::invalid_argument(R"(The "distributions" must be an array of strings in the "sweep" object)");
+    }
+    if (paramSweep.contains("engines")) {
+        if (!paramSweep["engines"].is_array()) throw std::invalid_argument(R"(The "engines" must be an array of strings in the "sweep" object)");
+        engines.clear();
+        for (auto &engineName : paramSweep["engines"].get<std::vector<std::string>>()) {
+            ENGINE engine = CostModel::getEngineFromName(engineName);
+            if (engine == ALL || engine == AUTO) throw std::invalid_argument(R"(The "engines" of the "sweep" object can't be "all" or "auto")");
+            engines.push_back(engine);
+        }
+    }
+    if (paramSweep.contains("memoryLimit")) {
+        if (paramSweep["memoryLimit"].is_number_unsigned()) memoryLimit = paramSweep["memoryLimit"].get<size_t>();
+        else throw std::invalid_argument(R"(The "memoryLimit" must be an unsigned integer in the "sweep" object)");
+    }
+    // by default, half of the physical memory
+    if (memoryLimit == 0) memoryLimit = static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<size_t>(sysconf(_SC_PAGE_SIZE)) / 2;
+    if (paramSweep.contains("baseline")) {
+        if (paramSweep["baseline"].is_string()) baselinePath = paramSweep["baseline"].get<std::string>();
+        else throw std::invalid_argument(R"(The "baseline" must be a string in the "sweep" object)");
+    }
+    if (paramSweep.contains("updateBaseline")) {
+        if (paramSweep["updateBaseline"].is_boolean()) updateBaseline = paramSweep["updateBaseline"];
+        else throw std::invalid_argument(R"(The "updateBaseline" must be a boolean in the "sweep" object)");
+    }
+    if (paramSweep.contains("tolerance")) {
+        if (paramSweep["tolerance"].is_number() && paramSweep["tolerance"] >= 0) tolerance = paramSweep["tolerance"];
+        else throw std::invalid_argument(R"(The "tolerance" must be a non-negative number in the "sweep" object)");
+    }
+    if (paramSweep.contains("minTime")) {
+        if (paramSweep["minTime"].is_number() && paramSweep["minTime"] >= 0) minTime = paramSweep["minTime"];
+        else throw std::invalid_argument(R"(The "minTime" must be a non-negative number in the "sweep" object)");
+    }
+    // the points of a series are fitted in increasing order of n
+    std::sort(listN.begin(), listN.end());
+}
+
+void ScalingSweep::run() {
+    TRACE_SCOPE("ScalingSweep::run");
+    points.clear();
+    // the generated instance is kept, each engine solves a copy of it so that no engine gets jobs sorted by another one
+    Instance generated;
+    Instance instance;
+    generated.setSeed(seed);
+    for (auto &distribution : listDistributions) {
+        for (auto pmax : listPMax) {
+            for (auto n : listN) {
+                size_t estimatedBytes = 0;
+                for (ENGINE engine : engines) estimatedBytes = std::max(estimatedBytes, Solver::estimateMemory(n, engine));
+                estimatedBytes += n * sizeof(Instance::Job);
+                if (estimatedBytes > memoryLimit) {
+                    std::cerr << "The sweep skips n = " << n << ", it needs about " << estimatedBytes << " bytes, more than the memory limit of " << memoryLimit << " bytes" << std::endl;
+                    continue;
+                }
+                nlohmann::json paramInstance = {{"n", n}, {"distribution", distribution}, {"pi", {{"inf", 1u}, {"sup", pmax}}}};
+                std::vector<std::vector<double>> times(engines.size());
+                std::vector<std::vector<double>> timesSolve(engines.size());
+                for (unsigned int repetition = 0; repetition < repetitions; ++repetition) {
+                    generated.clearListJobs();
+                    generated.generateInstance(paramInstance);
+                    for (size_t indexEngine = 0; indexEngine < engines.size(); ++indexEngine) {
+                        instance = generated;
+                        Solver solver(&instance, true);
+                        solver.setEngine(engines[indexEngine]);
+                        auto start = std::chrono::steady_clock::now();
+                        solver.solve();
+                        std::chrono::duration<double> timeSolve = std::chrono::steady_clock::now() - start;
+                        times[indexEngine].push_back(solver.getTimeEngine().count());
+                        timesSolve[indexEngine].push_back(timeSolve.count());
+                    }
+                }
+                for (size_t indexEngine = 0; indexEngine < engines.size(); ++indexEngine) {
+                    Point point;
+                    point.engine = engines[indexEngine];
+                    point.distribution = distribution;
+                    point.pmax = pmax;
+                    point.n = n;
+                    point.time = median(times[indexEngine]);
+                    point.timeSolve = median(timesSolve[indexEngine]);
+                    points.push_back(point);
+                }
+            }
+        }
+    }
+    size_t nbRegressions = baselinePath.empty() ? 0 : compareToBaseline();
+    printOutput();
+    if (!baselinePath.empty() && (updateBaseline || !std::filesystem::exists(baselinePath))) saveBaseline();
+    if (nbRegressions > 0)
+        throw F2CmaxException(std::to_string(nbRegressions).append(" times of the sweep are more than ").append(std::to_string(std::lround(tolerance * 100.0)))
+            .append("% slower than the baseline ").append(baselinePath.string()).append(", see the column Regression of the results").c_str());
+}
+
+ScalingSweep::Fit ScalingSweep::fitComplexity(const std::vector<std::pair<double,double>> &samples) {
+    Fit fit;
+    std::vector<double> ratiosN;
+    std::vector<double> ratiosNLogN;
+    double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+    size_t nbSamples = 0;
+    for (auto &[n,time] : samples) {
+        if (n < 2.0 || time <= 0.0) continue;
+        ratiosN.push_back(time / n);
+        ratiosNLogN.push_back(time / (n * std::log2(n)));
+        double x = std::log(n);
+        double y = std::log(time);
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+        ++nbSamples;
+    }
+    if (nbSamples == 0) return fit;
+    std::tie(fit.coefN, fit.spreadN) = medianAndSpread(ratiosN);
+    std::tie(fit.coefNLogN, fit.spreadNLogN) = medianAndSpread(ratiosNLogN);
+    double denominator = static_cast<double>(nbSamples) * sumXX - sumX * sumX;
+    if (nbSamples > 1 && denominator > 0.0) fit.exponent = (static_cast<double>(nbSamples) * sumXY - sumX * sumY) / denominator;
+    return fit;
+}
+
+size_t ScalingSweep::compareToBaseline() {
+    if (!std::filesystem::exists(baselinePath)) return 0;
+    std::ifstream fileStream(baselinePath);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(baselinePath.string()).c_str());
+    nlohmann::json baseline = nlohmann::json::parse(fileStream);
+    if (!baseline.contains("points") || !baseline["points"].is_object())
+        throw std::invalid_argument(std::string("The baseline file must have a \"points\" object: ").append(baselinePath.string()));
+    // the times of another machine are not comparable, they are compared anyway but the user is warned
+    std::string hostName = getHostName();
+    if (baseline.value("host", std::string()) != hostName)
+        std::cerr << "The baseline " << baselinePath.string() << " was recorded on the host " << baseline.value("host", std::string("unknown"))
+                  << ", not on " << hostName << std::endl;
+    size_t nbRegressions = 0;
+    for (auto &point : points) {
+        auto key = getPointKey(point.engine, point.distribution, point.pmax, point.n);
+        if (!baseline["points"].contains(key)) continue;
+        point.baselineTime = baseline["points"][key].get<double>();
+        if (point.baselineTime < minTime) continue;
+        point.regression = point.time > point.baselineTime * (1.0 + tolerance);
+        if (point.regression) ++nbRegressions;
+    }
+    return nbRegressions;
+}
+
+void ScalingSweep::saveBaseline() const {
+    nlohmann::json baseline = {{"host", getHostName()}, {"points", nlohmann::json::object()}};
+    // the points of the previous baseline which were not swept again are kept
+    if (std::filesystem::exists(baselinePath)) {
+        std::ifstream fileStream(baselinePath);
+        nlohmann::json previous = nlohmann::json::parse(fileStream);
+        if (previous.contains("points") && previous["points"].is_object()) baseline["points"] = previous["points"];
+    }
+    for (auto &point : points) baseline["points"][getPointKey(point.engine, point.distribution, point.pmax, point.n)] = point.time;
+    if (baselinePath.has_parent_path()) std::filesystem::create_directories(baselinePath.lexically_normal().parent_path());
+    std::ofstream fileStream(baselinePath);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(baselinePath.string()).c_str());
+    fileStream << baseline.dump(4) << std::endl;
+}
+
+void ScalingSweep::printOutput() const {
+    std::filesystem::create_directories(outputDir);
+    auto resultsPath = outputDir / "resultsSweep.csv";
+    bool resultsExist = std::filesystem::exists(resultsPath);
+    std::ofstream resultsFile(resultsPath, std::ios::out | std::ios::app | std::ios::ate);
+    if (!resultsExist)
+        resultsFile << "Engine" << "\t" << "Distribution" << "\t" << "pmax" << "\t" << "n" << "\t" << "TimeEngine" << "\t" << "TimeSolve"
+                    << "\t" << "TimePerN" << "\t" << "TimePerNLogN" << "\t" << "BaselineTime" << "\t" << "Regression" << "\t" << "Allocation" << std::endl;
+    // the series of each engine, distribution and pmax, in increasing order of n
+    std::map<std::string, std::vector<std::pair<double,double>>> series;
+    for (auto &point : points) {
+        auto n = static_cast<double>(point.n);
+        resultsFile << CostModel::getEngineName(point.engine)
+                    << "\t" << point.distribution
+                    << "\t" << point.pmax
+                    << "\t" << point.n
+                    << "\t" << point.time
+                    << "\t" << point.timeSolve
+                    << "\t" << point.time / n
+                    << "\t" << (n < 2.0 ? 0.0 : point.time / (n * std::log2(n)))
+                    << "\t" << point.baselineTime
+                    << "\t" << point.regression
+                    << "\t" << AllocationPolicy::getName() << std::endl;
+        series[CostModel::getEngineName(point.engine).append("\t").append(point.distribution).append("\t").append(std::to_string(point.pmax))].emplace_back(n, point.time);
+    }
+
+    auto fitsPath = outputDir / "fitsSweep.csv";
+    bool fitsExist = std::filesystem::exists(fitsPath);
+    std::ofstream fitsFile(fitsPath, std::ios::out | std::ios::app | std::ios::ate);
+    if (!fitsExist)
+        fitsFile << "Engine" << "\t" << "Distribution" << "\t" << "pmax" << "\t" << "Exponent" << "\t" << "CoefN" << "\t" << "SpreadN"
+                 << "\t" << "CoefNLogN" << "\t" << "SpreadNLogN" << "\t" << "Model" << std::endl;
+    for (auto &[seriesName, samples] : series) {
+        Fit fit = fitComplexity(samples);
+        // the model whose ratio is the most constant over n
+        fitsFile << seriesName
+                 << "\t" << fit.exponent
+                 << "\t" << fit.coefN
+                 << "\t" << fit.spreadN
+                 << "\t" << fit.coefNLogN
+                 << "\t" << fit.spreadNLogN
+                 << "\t" << (fit.spreadN <= fit.spreadNLogN ? "n" : "nlogn") << std::endl;
+    }
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "Server.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+Server::Server(unsigned int nbThreads) : nbThreads(std::max(1u, nbThreads)) {}
+
+std::string Server::handleRequest(const std::string &request, Worker &worker) {
+    TRACE_SCOPE("Server::handleRequest");
+    nlohmann::json answer = nlohmann::json::object();
+    try {
+        nlohmann::json parameters = nlohmann::json::parse(request);
+        if (!parameters.is_object()) throw std::invalid_argument("The request must be a JSON object");
+        if (parameters.contains("id")) answer["id"] = parameters["id"];
+        if (parameters.contains("command")) {
+            if (parameters["command"] != "shutdown") throw std::invalid_argument(R"(The "command" is not known)");
+            stopRequested.store(true);
+            // wake up the workers waiting for a connection or for a request
+            if (listenSocket >= 0) ::shutdown(listenSocket, SHUT_RDWR);
+            stopConnections();
+            answer["status"] = "shutdown";
+            return answer.dump();
+        }
+        bool withPermutation = false;
+        if (parameters.contains("permutation")) {
+            if (parameters["permutation"].is_boolean()) withPermutation = parameters["permutation"].get<bool>();
+            else throw std::invalid_argument(R"(The "permutation" must be a boolean)");
+        }
+        Instance &instance = worker.instance;
+        if (parameters.contains("jobs")) {
+            auto &jobs = parameters["jobs"];
+            if (!jobs.is_array()) throw std::invalid_argument(R"(The "jobs" must be an array of [p1,p2])");
+            instance.reset();
+            instance.setNbJobs(static_cast<unsigned int>(jobs.size()));
+            for (auto &job : jobs) {
+                if (!job.is_array() || job.size() != 2 || !job[0].is_number() || !job[1].is_number())
+                    throw std::invalid_argument(R"(The "jobs" must be an array of [p1,p2])");
+                instance.addJob(job[0].get<double>(), job[1].get<double>());
+            }
+        } else if (parameters.contains("path")) {
+            if (!parameters["path"].is_string()) throw std::invalid_argument(R"(The "path" must be a string)");
+            std::string path = parameters["path"];
+            if (!std::filesystem::exists(path)) throw F2CmaxException(std::string("The instance does not exist. Path: ").append(path));
+            worker.parser.readFromFile(path, instance);
+        } else throw std::invalid_argument(R"(The request must have "jobs" or "path")");
+
+        worker.solver.setEngine(withPermutation ? PERMUTATION : CMAX_ONLY);
+        worker.solver.solve();
+        answer["cmax"] = worker.solver.getObjective();
+        if (withPermutation) answer["permutation"] = worker.solver.getPermutation();
+    } catch (const std::exception &e) {
+        answer["error"] = e.what();
+    }
+    return answer.dump();
+}
+
+void Server::serveStream(std::istream &input, std::ostream &output) {
+    Worker worker;
+    std::string request;
+    while (!stopRequested.load() && std::getline(input, request)) {
+        if (request.empty()) continue;
+        output << handleRequest(request, worker) << std::endl;
+    }
+}
+
+void Server::serveConnection(int connection, Worker &worker) {
+    std::string pending;
+    std::string answers;
+    char chunk[1 << 16];
+    while (!stopRequested.load()) {
+        ssize_t nbRead = ::recv(connection, chunk, sizeof(chunk), 0);
+        if (nbRead < 0 && errno == EINTR) continue;
+        if (nbRead <= 0) return;
+        pending.append(chunk, static_cast<size_t>(nbRead));
+        // answer every complete line of the chunk, the answers are sent together
+        size_t begin = 0;
+        size_t end;
+        while ((end = pending.find('\n', begin)) != std::string::npos) {
+            if (end > begin) answers.append(handleRequest(pending.substr(begin, end - begin), worker)).push_back('\n');
+            begin = end + 1;
+        }
+        pending.erase(0, begin);
+        size_t nbSent = 0;
+        while (nbSent < answers.size()) {
+            ssize_t nbWritten = ::send(connection, answers.data() + nbSent, answers.size() - nbSent, MSG_NOSIGNAL);
+            if (nbWritten < 0 && errno == EINTR) continue;
+            if (nbWritten <= 0) return;
+            nbSent += static_cast<size_t>(nbWritten);
+        }
+        answers.clear();
+    }
+}
+
+void Server::stopConnections() {
+    std::lock_guard lock(connectionsMutex);
+    for (int connection : connections) ::shutdown(connection, SHUT_RD);
+}
+
+void Server::serveSocket(const std::string &socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) throw std::invalid_argument(R"(The "socket" path is too long)");
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0) throw F2CmaxException(std::string("Can't create the socket: ").append(std::strerror(errno)).c_str());
+    ::unlink(socketPath.c_str());
+    if (::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listenSocket, SOMAXCONN) < 0) {
+        std::string error = std::string("Can't listen on the socket ").append(socketPath).append(": ").append(std::strerror(errno));
+        ::close(listenSocket);
+        listenSocket = -1;
+        throw F2CmaxException(error.c_str());
+    }
+
+    // each worker accepts a connection and serves it until it is closed. At the shutdown, the reading side of the open
+    // connections is shut down: their workers answer the requests already received, then stop at their next read even if
+    // their clients keep them open
+    std::vector<std::thread> workers;
+    for (unsigned int thread = 0; thread < nbThreads; ++thread) {
+        workers.emplace_back([this]() {
+            auto worker = std::make_unique<Worker>();
+            while (!stopRequested.load()) {
+                int connection = ::accept(listenSocket, nullptr, nullptr);
+                if (connection < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) continue;
+                    return;
+                }
+                {
+                    // a connection accepted while the shutdown stops the other ones is stopped here
+                    std::lock_guard lock(connectionsMutex);
+                    connections.push_back(connection);
+                    if (stopRequested.load()) ::shutdown(connection, SHUT_RD);
+                }
+                serveConnection(connection, *worker);
+                {
+                    std::lock_guard lock(connectionsMutex);
+                    connections.erase(std::find(connections.begin(), connections.end(), connection));
+                }
+                ::close(connection);
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+    ::close(listenSocket);
+    listenSocket = -1;
+    ::unlink(socketPath.c_str());
+}
@@ -0,0 +1,232 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#include "Shard.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "F2CmaxException.h"
+#include "Trace.h"
+
+namespace {
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    /**
+     * Method that splits a line of a results file into its columns.
+     */
+    std::vector<std::string> splitColumns(const std::string &line) {
+        std::vector<std::string> columns;
+        std::stringstream lineStream(line);
+        std::string column;
+        while (std::getline(lineStream, column, '\t')) columns.push_back(column);
+        return columns;
+    }
+
+    /**
+     * Method that opens the merged file, its parent directory is created.
+     */
+    std::ofstream openMerged(const std::filesystem::path &path) {
+        if (path.has_parent_path()) std::filesystem::create_directories(path.lexically_normal().parent_path());
+        std::ofstream outputFile(path, std::ios::out | std::ios::trunc);
+        if (!outputFile.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(path.string()).c_str());
+        return outputFile;
+    }
+
+    /**
+     * Method that merges the shards of a results file with one row per instance. The header is the one of the first
+     * shard, the rows are stably sorted by the column InstancePath (the second one). Nothing is written if no shard
+     * wrote the file.
+     */
+    void mergeRows(const std::filesystem::path &path, const std::vector<std::filesystem::path> &shardPaths) {
+        std::string header;
+        std::vector<std::pair<std::string, std::string>> rows; // (instance path, row)
+        bool found = false;
+        for (auto &shardPath : shardPaths) {
+            std::ifstream shardFile(shardPath);
+            if (!shardFile.is_open()) continue;
+            found = true;
+            std::string line;
+            if (std::getline(shardFile, line) && header.empty()) header = line;
+            while (std::getline(shardFile, line)) {
+                if (line.empty()) continue;
+                auto columns = splitColumns(line);
+                rows.emplace_back(columns.size() > 1 ? columns[1] : std::string(), line);
+            }
+        }
+        if (!found) return;
+        std::stable_sort(rows.begin(), rows.end(), [](auto &rowLeft, auto &rowRight) { return rowLeft.first < rowRight.first; });
+        std::ofstream outputFile = openMerged(path);
+        outputFile << header << '\n';
+        for (auto &[instancePath, row] : rows) outputFile << row << '\n';
+    }
+
+    // The statistics of one column of one group of a summary
+    struct SummaryLine {
+        std::string engine;
+        std::string column;
+        double count = 0.0;
+        double mean = 0.0;
+        double sumSquares = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        std::vector<double> quantiles;
+    };
+
+    /**
+     * Method that merges the shards of a summary file. The count, the mean, the standard deviation, the minimum and the
+     * maximum of a column of a group are combined without approximation (Chan's formula for the variance), up to the
+     * rounding of the arithmetic, as the summaries are written with all the digits of their values. Its quantiles are
+     * the means of the quantiles of the shards weighted by their counts, which is an approximation. The groups are sorted by
+     * method, distribution, pmax and n, and their columns are in the order of the first shard which has them. Nothing
+     * is written if no shard wrote the file.
+     */
+    void mergeSummary(const std::filesystem::path &path, const std::vector<std::filesystem::path> &shardPaths) {
+        typedef std::tuple<size_t, std::string, double, unsigned long> Group;
+        std::string header;
+        size_t nbQuantiles = 0;
+        std::map<Group, std::vector<SummaryLine>> groups;
+        bool found = false;
+        for (auto &shardPath : shardPaths) {
+            std::ifstream shardFile(shardPath);
+            if (!shardFile.is_open()) continue;
+            found = true;
+            std::string line;
+            if (!std::getline(shardFile, line)) continue;
+            if (header.empty()) {
+                header = line;
+                // Method, Engine, Distribution, pmax, n, Column, Count, Mean, StdDev, Min, the quantiles and Max
+                nbQuantiles = splitColumns(header).size() - 11;
+            } else if (line != header) throw F2CmaxException(std::string("The summary ").append(shardPath.string()).append(" does not have the quantiles of the other shards").c_str());
+            while (std::getline(shardFile, line)) {
+                if (line.empty()) continue;
+                auto columns = splitColumns(line);
+                if (columns.size() != 11 + nbQuantiles) throw F2CmaxException(std::string("The summary ").append(shardPath.string()).append(" has a line with a wrong number of columns").c_str());
+                Group group{std::stoul(columns[0]), columns[2], std::stod(columns[3]), std::stoul(columns[4])};
+                SummaryLine shardLine;
+                shardLine.engine = columns[1];
+                shardLine.column = columns[5];
+                shardLine.count = std::stod(columns[6]);
+                shardLine.mean = std::stod(columns[7]);
+                double stdDev = std::stod(columns[8]);
+                shardLine.sumSquares = stdDev * stdDev * std::max(0.0, shardLine.count - 1.0);
+                shardLine.min = std::stod(columns[9]);
+                for (size_t indexQuantile = 0; indexQuantile < nbQuantiles; ++indexQuantile) shardLine.quantiles.push_back(std::stod(columns[10 + indexQuantile]));
+                shardLine.max = std::stod(columns[10 + nbQuantiles]);
+
+                auto &lines = groups[group];
+                auto it = std::find_if(lines.begin(), lines.end(), [&shardLine](auto &other) { return other.column == shardLine.column; });
+                if (it == lines.end()) {
+                    lines.push_back(shardLine);
+                    continue;
+                }
+                double count = it->count + shardLine.count;
+                double delta = shardLine.mean - it->mean;
+                it->sumSquares += shardLine.sumSquares + delta * delta * it->count * shardLine.count / count;
+                it->mean += delta * shardLine.count / count;
+                for (size_t indexQuantile = 0; indexQuantile < nbQuantiles; ++indexQuantile)
+                    it->quantiles[indexQuantile] = (it->quantiles[indexQuantile] * it->count + shardLine.quantiles[indexQuantile] * shardLine.count) / count;
+                it->min = std::min(it->min, shardLine.min);
+                it->max = std::max(it->max, shardLine.max);
+                it->count = count;
+            }
+        }
+        if (!found) return;
+        std::ofstream outputFile = openMerged(path);
+        outputFile << header << '\n';
+        outputFile.precision(std::numeric_limits<double>::max_digits10);
+        for (auto &[group, lines] : groups) {
+            auto &[method, distribution, pmax, n] = group;
+            for (auto &summaryLine : lines) {
+                outputFile << method << "\t" << summaryLine.engine << "\t" << distribution << "\t" << pmax << "\t" << n
+                           << "\t" << summaryLine.column << "\t" << summaryLine.count << "\t" << summaryLine.mean
+                           << "\t" << (summaryLine.count < 2 ? 0.0 : std::sqrt(summaryLine.sumSquares / (summaryLine.count - 1)))
+                           << "\t" << summaryLine.min;
+                for (double quantile : summaryLine.quantiles) outputFile << "\t" << quantile;
+                outputFile << "\t" << summaryLine.max << '\n';
+            }
+        }
+    }
+}
+
+Shard::Shard(unsigned int index, unsigned int count) : index(index), count(count) {
+    if (count == 0 || index >= count) throw std::invalid_argument("The shard must be i/N with N at least 1 and i smaller than N");
+}
+
+Shard Shard::parse(const std::string &shardText) {
+    auto pos = shardText.find('/');
+    size_t endIndex = 0;
+    size_t endCount = 0;
+    unsigned long shardIndex = 0;
+    unsigned long shardCount = 0;
+    try {
+        if (pos != std::string::npos && pos > 0 && pos + 1 < shardText.size()) {
+            shardIndex = std::stoul(shardText.substr(0, pos), &endIndex);
+            shardCount = std::stoul(shardText.substr(pos + 1), &endCount);
+        }
+    } catch (const std::logic_error &) {
+        endIndex = 0; // reported below
+    }
+    if (endIndex == 0 || endIndex != pos || endCount != shardText.size() - pos - 1)
+        throw std::invalid_argument(std::string("The shard must be written i/N, not ").append(shardText));
+    return {static_cast<unsigned int>(shardIndex), static_cast<unsigned int>(shardCount)};
+}
+
+uint64_t Shard::hashPath(const std::string &path) {
+    std::string normalizedPath = std::filesystem::path(path).lexically_normal().string();
+    uint64_t hash = FNV_OFFSET;
+    for (unsigned char character : normalizedPath) {
+        hash ^= character;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::string Shard::getPath(const std::string &filePath) const {
+    if (count == 1) return filePath;
+    auto path = std::filesystem::path(filePath);
+    std::string suffix = "_shard" + std::to_string(index) + "of" + std::to_string(count);
+    return path.replace_filename(path.stem().string() + suffix + path.extension().string()).string();
+}
+
+void Shard::merge(const std::string &outputDir, unsigned int count) {
+    TRACE_SCOPE("Shard::merge");
+    if (count == 0) throw std::invalid_argument(R"(The "shards" must be at least 1 in the "merge" object)");
+    for (const std::string fileName : {"resultsF2Cmax.csv", "resultsF2CmaxOutOfCore.csv", "resultsFlowShop.csv", "summaryF2Cmax.csv"}) {
+        auto path = std::filesystem::path(outputDir) / fileName;
+        std::vector<std::filesystem::path> shardPaths;
+        for (unsigned int indexShard = 0; indexShard < count; ++indexShard) shardPaths.emplace_back(Shard(indexShard, count).getPath(path.string()));
+        if (fileName == "summaryF2Cmax.csv") mergeSummary(path, shardPaths);
+        else mergeRows(path, shardPaths);
+    }
+}
@@ -0,0 +1,612 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "SolvePlan.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#include "ExternalSolver.h"
+#include "FlowShopSolver.h"
+#include "MemoryTracker.h"
+#include "Solver.h"
+#include "SpscQueue.h"
+#include "Trace.h"
+
+namespace {
+    // the times of a cached result are not known, they are not counted in the summary
+    constexpr std::array<double, Solver::NB_TIMES> CACHED_TIMES = [] {
+        std::array<double, Solver::NB_TIMES> times{};
+        times.fill(std::numeric_limits<double>::quiet_NaN());
+        return times;
+    }();
+}
+
+SolvePlan::SolvePlan(const nlohmann::json &paramSolve, const Shard &shard) {
+    TRACE_SCOPE("SolvePlan::SolvePlan");
+    // set verbose mode
+    verbose = paramSolve.contains("verbose") && paramSolve["verbose"].is_number_unsigned()
+              ? paramSolve["verbose"].template get<char>() : 0;
+    bool costModelLoaded = false;
+    if (paramSolve.contains("resultCache")) {
+        if (paramSolve["resultCache"].is_string()) resultCachePath = shard.getPath(paramSolve["resultCache"].get<std::string>());
+        else throw std::invalid_argument(R"(The "resultCache" must be a string)");
+    }
+    if (paramSolve.contains("memoryLimit")) {
+        if (paramSolve["memoryLimit"].is_number_unsigned()) memoryLimit = paramSolve["memoryLimit"].get<size_t>();
+        else throw std::invalid_argument(R"(The "memoryLimit" must be an unsigned integer)");
+    }
+    if (paramSolve.contains("pipeline")) {
+        auto &pipeline = paramSolve["pipeline"];
+        if (!pipeline.is_object()) throw std::invalid_argument(R"(The "pipeline" must be an object)");
+        pipelineDepth = 2;
+        if (pipeline.contains("depth")) {
+            if (pipeline["depth"].is_number_unsigned()) pipelineDepth = pipeline["depth"].get<size_t>();
+            else throw std::invalid_argument(R"(The "depth" must be an unsigned integer in the "pipeline" object)");
+        }
+    }
+    if (paramSolve.contains("summary")) {
+        auto &paramSummary = paramSolve["summary"];
+        if (!paramSummary.is_object()) throw std::invalid_argument(R"(The "summary" must be an object)");
+        std::vector<double> quantiles{0.5, 0.9, 0.99};
+        if (paramSummary.contains("quantiles")) {
+            if (paramSummary["quantiles"].is_array()) quantiles = paramSummary["quantiles"].get<std::vector<double>>();
+            else throw std::invalid_argument(R"(The "quantiles" must be an array of numbers in the "summary" object)");
+        }
+        if (paramSummary.contains("rows")) {
+            if (paramSummary["rows"].is_boolean()) writeRows = paramSummary["rows"].get<bool>();
+            else throw std::invalid_argument(R"(The "rows" must be a boolean in the "summary" object)");
+        }
+        summary = std::make_unique<SummaryStatistics>(quantiles);
+    }
+    if (paramSolve.contains("forceSolve")) {
+        if (paramSolve["forceSolve"].is_boolean()) forceSolve = paramSolve["forceSolve"].get<bool>();
+        else throw std::invalid_argument(R"(The "forceSolve" must be a boolean)");
+    }
+
+    if (!paramSolve.contains("methods")) throw std::invalid_argument(R"(The config don't have attribute "methods")");
+    // for each method
+    for (auto &paramMethod: paramSolve["methods"]) {
+        Method &method = methods.emplace_back();
+        // set output path
+        std::string outputPath;
+        if (paramSolve.contains("output") && paramSolve["output"].is_string())
+            outputPath = std::filesystem::path(paramSolve["output"].template get<std::string>());
+        else {
+            outputPath = std::filesystem::current_path().parent_path().parent_path().string() +
+                         "/instances/";
+        }
+
+        // keep the path without the extension and add the name method;
+        // each shard writes its own files, see Shard::merge
+        method.outputOutOfCorePath = shard.getPath(outputPath + "resultsF2CmaxOutOfCore.csv");
+        method.outputFlowShopPath = shard.getPath(outputPath + "resultsFlowShop.csv");
+        summaryPath = shard.getPath(outputPath + "summaryF2Cmax.csv");
+        method.outputPath = shard.getPath(outputPath.append("resultsF2Cmax.csv"));
+        if (verbose >= 2) std::cout << "Save results in the path : " << method.outputPath << std::endl;
+
+        if (paramMethod.contains("useRevisited")) {
+            if (paramMethod["useRevisited"].is_boolean()) method.useRevisited = paramMethod["useRevisited"];
+            else throw std::invalid_argument(R"(The "useRevisited" must be an boolean)");
+        }
+        if (paramMethod.contains("engine")) {
+            if (paramMethod["engine"].is_string()) method.engine = CostModel::getEngineFromName(paramMethod["engine"].get<std::string>());
+            else throw std::invalid_argument(R"(The "engine" must be a string)");
+        }
+        // number of threads parsing each instance file
+        if (paramMethod.contains("parserThreads")) {
+            if (paramMethod["parserThreads"].is_number_unsigned()) method.parserThreads = paramMethod["parserThreads"].get<unsigned int>();
+            else throw std::invalid_argument(R"(The "parserThreads" must be an unsigned integer)");
+        }
+        // number of threads partitioning the sets in the selection of the revisited algorithm
+        if (paramMethod.contains("partitionThreads")) {
+            if (paramMethod["partitionThreads"].is_number_unsigned()) method.partitionThreads = paramMethod["partitionThreads"].get<unsigned int>();
+            else throw std::invalid_argument(R"(The "partitionThreads" must be an unsigned integer)");
+        }
+        if (paramMethod.contains("prefixSort")) {
+            if (paramMethod["prefixSort"].is_string()) method.prefixSort = paramMethod["prefixSort"].get<std::string>();
+            else throw std::invalid_argument(R"(The "prefixSort" must be a string)");
+        }
+        // directory of the schedules of the instances
+        if (paramMethod.contains("schedule")) {
+            if (paramMethod["schedule"].is_string()) method.scheduleDir = paramMethod["schedule"].get<std::string>();
+            else throw std::invalid_argument(R"(The "schedule" must be a string)");
+        }
+        if (summary) summary->setEngineName(methods.size() - 1, CostModel::getEngineName(method.engine));
+        if (method.engine == REVISITED && not method.useRevisited) throw std::invalid_argument(R"(The engine "revisited" cannot be used with "useRevisited" set to false)");
+        if (method.engine == AUTO && not costModelLoaded) {
+            if (paramSolve.contains("calibration")) {
+                if (paramSolve["calibration"].is_string()) costModel.loadOrCalibrate(paramSolve["calibration"].get<std::string>());
+                else throw std::invalid_argument(R"(The "calibration" must be a string)");
+                if (verbose >= 1) std::cout << "Coefficients of the cost model : " << costModel.getCoefficients() << std::endl;
+            }
+            else std::cerr << R"(No "calibration" file is set, the engine "auto" uses the default coefficients of the cost model )"
+                           << costModel.getCoefficients() << ", which are not fitted on this machine" << std::endl;
+            costModelLoaded = true;
+        }
+
+        // parameters of the out-of-core solver
+        method.useOutOfCore = paramMethod.contains("outOfCore");
+        method.tmpDir = std::filesystem::temp_directory_path();
+        if (method.useOutOfCore) {
+            auto &outOfCore = paramMethod["outOfCore"];
+            if (!outOfCore.is_object()) throw std::invalid_argument(R"(The "outOfCore" must be an object)");
+            if (outOfCore.contains("memoryBudget")) {
+                if (outOfCore["memoryBudget"].is_number_unsigned()) method.memoryBudget = outOfCore["memoryBudget"].get<size_t>();
+                else throw std::invalid_argument(R"(The "memoryBudget" must be an unsigned integer in the "outOfCore" object)");
+            }
+            if (outOfCore.contains("tmpDir")) {
+                if (outOfCore["tmpDir"].is_string()) method.tmpDir = outOfCore["tmpDir"].get<std::string>();
+                else throw std::invalid_argument(R"(The "tmpDir" must be a string in the "outOfCore" object)");
+            }
+            if (outOfCore.contains("schedule")) {
+                if (outOfCore["schedule"].is_string()) method.scheduleDir = outOfCore["schedule"].get<std::string>();
+                else throw std::invalid_argument(R"(The "schedule" must be a string in the "outOfCore" object)");
+            }
+        }
+
+        // parameters of the permutation flow shop solver
+        method.useFlowShop = paramMethod.contains("flowShop");
+        if (method.useFlowShop) {
+            auto &flowShop = paramMethod["flowShop"];
+            if (!flowShop.is_object()) throw std::invalid_argument(R"(The "flowShop" must be an object)");
+            if (flowShop.contains("threads")) {
+                if (flowShop["threads"].is_number_unsigned()) method.nbThreads = flowShop["threads"].get<unsigned int>();
+                else throw std::invalid_argument(R"(The "threads" must be an unsigned integer in the "flowShop" object)");
+            }
+        }
+
+        if (paramMethod.contains("instances")) {
+            // loop over each instances
+            for (auto &paramInstance: paramMethod["instances"]) {
+                Task &task = tasks.emplace_back();
+                task.method = methods.size() - 1;
+                // instance streamed from stdin ("path":"-") or from an inherited file descriptor ("fd")
+                if (paramInstance.contains("fd")) {
+                    if (paramInstance["fd"].is_number_unsigned()) task.fileDescriptor = paramInstance["fd"].get<int>();
+                    else throw std::invalid_argument(R"(The instance "fd" must be an unsigned integer)");
+                } else if (paramInstance.contains("path")) {
+                    if (paramInstance["path"].is_string()) task.path = paramInstance["path"];
+                    else throw std::invalid_argument(R"(The instance path is not a string)");
+                    if (task.path == "-") task.fileDescriptor = 0;
+                } else throw std::invalid_argument(R"(The instance don't have attribute "path")");
+                if (task.fileDescriptor >= 0 && (method.useOutOfCore || method.useFlowShop))
+                    throw std::invalid_argument(R"(An instance read from a stream can't be solved "outOfCore" or with "flowShop")");
+                // the jobs of a stream are split while they are read by the other engines, their ids are lost
+                if (task.fileDescriptor >= 0 && !method.scheduleDir.empty() && method.engine != ALL && method.engine != PERMUTATION)
+                    throw std::invalid_argument(R"(An instance read from a stream can write its "schedule" only with the engines "all" and "permutation")");
+                // an instance file is solved by its shard only, a stream by the first shard
+                if (task.fileDescriptor >= 0 ? shard.getIndex() != 0 : !shard.contains(task.path)) tasks.pop_back();
+            }
+        }
+    }
+}
+
+void SolvePlan::checkMemoryLimit(const std::string &path, const std::vector<size_t> &sameFile) const {
+    size_t nbJobs = peekNbJobs(path);
+    // the cached instance, parsed in place even by several threads, and the copy solved by the most demanding method
+    size_t estimatedBytes = nbJobs * sizeof(Instance::Job);
+    size_t solverBytes = 0;
+    for (size_t indexTask : sameFile) solverBytes = std::max(solverBytes, Solver::estimateMemory(nbJobs, methods[tasks[indexTask].method].engine));
+    estimatedBytes += solverBytes;
+    size_t liveBytes = MemoryTracker::getLiveBytes();
+    if (liveBytes + estimatedBytes > memoryLimit)
+        throw F2CmaxException(std::string("The instance ").append(path).append(" needs about ").append(std::to_string(estimatedBytes))
+            .append(" bytes with ").append(std::to_string(liveBytes)).append(" bytes in use, more than the memory limit of ")
+            .append(std::to_string(memoryLimit)).append(" bytes").c_str());
+}
+
+size_t SolvePlan::peekNbJobs(const std::string &path) {
+    // the attribute "n:" is in the first lines of the file, before the jobs
+    std::ifstream fileStream(path);
+    if (!fileStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(path).c_str());
+    std::string line;
+    while (std::getline(fileStream, line)) {
+        auto pos = line.find(':');
+        if (pos == std::string::npos) break;
+        if (line.compare(0, pos, "n") == 0) return std::stoul(line.substr(pos + 1));
+    }
+    // without "n:", each job line has at least 4 bytes ("1 2\n")
+    return std::filesystem::file_size(path) / 4;
+}
+
+bool SolvePlan::isInMemory(const Task &task) const {
+    const Method &method = methods[task.method];
+    return task.fileDescriptor < 0 && !method.useOutOfCore && !method.useFlowShop;
+}
+
+std::vector<size_t> SolvePlan::findSameFile(size_t indexTask, const std::vector<bool> &done, unsigned int &parserThreads, bool &splitWhileParsing) const {
+    std::vector<size_t> sameFile;
+    parserThreads = 1;
+    splitWhileParsing = true;
+    auto normalizedPath = std::filesystem::path(tasks[indexTask].path).lexically_normal();
+    for (size_t indexOther = indexTask; indexOther < tasks.size(); ++indexOther) {
+        if (done[indexOther] || !isInMemory(tasks[indexOther])) continue;
+        if (std::filesystem::path(tasks[indexOther].path).lexically_normal() != normalizedPath) continue;
+        sameFile.push_back(indexOther);
+        parserThreads = std::max(parserThreads, methods[tasks[indexOther].method].parserThreads);
+        splitWhileParsing = splitWhileParsing && isSplitWhileReading(methods[tasks[indexOther].method]);
+    }
+    return sameFile;
+}
+
+bool SolvePlan::isSplitWhileReading(const Method &method) {
+    return method.engine != ALL && method.engine != PERMUTATION && method.scheduleDir.empty();
+}
+
+ResultCache::Result SolvePlan::runInMemory(size_t indexMethod, Instance &instance, const MemoryUsage &parseMemory, std::ostream *rowStream) {
+    const Method &method = methods[indexMethod];
+    std::ofstream outputFileStream;
+    Solver solver(&instance, method.useRevisited);
+    solver.setParseMemory(parseMemory);
+    solver.setEngine(method.engine);
+    solver.setCostModel(&costModel);
+    solver.setPrefixSort(method.prefixSort);
+    solver.setPartitionThreads(method.partitionThreads);
+    std::vector<uint32_t> order;
+    if (!method.scheduleDir.empty() && method.engine != PERMUTATION) {
+        // the other engines move the jobs: Johnson's order of the jobs in the order of the file is computed before, and
+        // outside of the times of the solver
+        Solver::computeJohnsonOrder(instance.getListJobs(), order);
+        writeSchedule(method, instance, ScheduleView(instance.getListJobs(), order));
+    }
+    solver.solve();
+    if (!method.scheduleDir.empty() && method.engine == PERMUTATION) writeSchedule(method, instance, solver.getSchedule());
+    if (rowStream != nullptr) solver.printRow(*rowStream);
+    else if (writeRows) {
+        std::string outputPath = method.outputPath;
+        solver.printOutput(outputPath, outputFileStream);
+    }
+
+    ResultCache::Result result;
+    result.instanceName = instance.getInstanceName();
+    result.nbJobs = instance.getNbJobs();
+    result.supPj = instance.getSupPj();
+    result.engine = solver.getSelectedEngine();
+    result.metrics = std::apply([](auto... metric) { return std::array<size_t,6>{metric...}; }, solver.getMetrics());
+    result.runs = solver.getRuns();
+    result.objective = solver.getObjective();
+    if (summary) addToSummary(indexMethod, result, solver.getTimes());
+    return result;
+}
+
+void SolvePlan::addToSummary(size_t indexMethod, const ResultCache::Result &result, const std::array<double, Solver::NB_TIMES> &times) {
+    std::array<double, SummaryStatistics::NB_COLUMNS> values{};
+    std::copy(times.begin(), times.end(), values.begin());
+    values[Solver::NB_TIMES] = static_cast<double>(result.metrics[1]);
+    values[Solver::NB_TIMES + 1] = static_cast<double>(result.metrics[4]);
+    summary->add({indexMethod, SummaryStatistics::getDistribution(result.instanceName), result.supPj, result.nbJobs}, values);
+}
+
+void SolvePlan::writeSchedule(const Method &method, const Instance &instance, const ScheduleView &schedule) const {
+    TRACE_SCOPE("SolvePlan::writeSchedule");
+    auto schedulePath = std::filesystem::path(method.scheduleDir) / instance.getScheduleFileName();
+    if (verbose >= 2) std::cout << "Save schedule in the path : " << schedulePath.string() << std::endl;
+    if (schedulePath.has_parent_path()) std::filesystem::create_directories(schedulePath.lexically_normal().parent_path());
+    std::ofstream scheduleStream(schedulePath, std::ios::out | std::ios::trunc);
+    if (!scheduleStream.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(schedulePath.string()).c_str());
+    schedule.write(scheduleStream);
+}
+
+void SolvePlan::runOutOfCore(const Method &method, std::string &path) const {
+    TRACE_SCOPE("SolvePlan::runOutOfCore");
+    if (verbose >= 2) std::cout << "Solving out-of-core instance : " << path << std::endl;
+    std::ofstream outputFileStream;
+    ExternalSolver externalSolver(path, method.memoryBudget, method.tmpDir);
+    if (!method.scheduleDir.empty()) externalSolver.setScheduleDir(method.scheduleDir);
+    externalSolver.solve();
+    std::string outputPath = method.outputOutOfCorePath;
+    externalSolver.printOutput(outputPath, outputFileStream);
+}
+
+void SolvePlan::runFlowShop(const Method &method, std::string &path, const Parser &parser) const {
+    TRACE_SCOPE("SolvePlan::runFlowShop");
+    if (verbose >= 2) std::cout << "Solving flow shop instance : " << path << std::endl;
+    std::ofstream outputFileStream;
+    FlowShopInstance flowShopInstance = parser.readFlowShopFromFile(path);
+    FlowShopSolver flowShopSolver(&flowShopInstance, method.nbThreads);
+    flowShopSolver.solve();
+    std::string outputPath = method.outputFlowShopPath;
+    flowShopSolver.printOutput(outputPath, outputFileStream);
+}
+
+void SolvePlan::runPipeline(const Parser &parser, InstanceCache &instanceCache, ResultCache *resultCache, InstancePool &instancePool, std::vector<bool> &done) {
+    TRACE_SCOPE("SolvePlan::runPipeline");
+    using Clock = std::chrono::steady_clock;
+    // The tasks of one instance file and its instance loaded by the reader
+    struct FileItem {
+        std::string path;
+        std::vector<size_t> sameFile;
+        std::vector<std::string> keys; // keys of the result cache of the tasks
+        std::vector<std::optional<ResultCache::Result>> cachedResults;
+        Instance *instance = nullptr; // instance of the ring, nullptr if every task has a cached result
+        MemoryUsage parseMemory; // parsing of the file, counted in the first method solved as without a pipeline
+        MemoryUsage copyMemory; // copy of the parsed instance in the ring, counted in the method which solves it
+        std::exception_ptr error;
+    };
+    // One row of a results file
+    struct RowItem {
+        std::string outputPath;
+        bool useRevisited = true;
+        std::string row;
+    };
+
+    // the files are grouped as by SolvePlan::run, in the order of their first task
+    std::vector<FileItem> files;
+    for (size_t indexTask = 0; indexTask < tasks.size(); ++indexTask) {
+        if (done[indexTask] || !isInMemory(tasks[indexTask])) continue;
+        FileItem &file = files.emplace_back();
+        unsigned int parserThreads;
+        bool splitWhileParsing;
+        file.path = tasks[indexTask].path;
+        file.sameFile = findSameFile(indexTask, done, parserThreads, splitWhileParsing);
+        for (size_t indexOther : file.sameFile) done[indexOther] = true;
+    }
+    if (files.empty()) return;
+
+    // the ring of instances, and the instance of the methods solved on a copy when a file has several methods
+    std::vector<InstancePool::Lease> ring;
+    SpscQueue<Instance *> freeInstances(pipelineDepth);
+    for (size_t indexSlot = 0; indexSlot < pipelineDepth; ++indexSlot) freeInstances.push(ring.emplace_back(instancePool.acquire()).get());
+    auto workInstance = instancePool.acquire();
+    SpscQueue<FileItem> readQueue(pipelineDepth);
+    SpscQueue<RowItem> writeQueue(pipelineDepth * methods.size() + 1);
+    std::mutex resultCacheMutex; // the reader finds the cached results while the solver inserts the new ones
+    Clock::duration busyRead{0}, busySolve{0}, busyWrite{0};
+    auto startPipeline = Clock::now();
+
+    std::thread reader([&]() {
+        TRACE_SCOPE("SolvePlan::runPipeline::read");
+        for (FileItem &file : files) {
+            auto start = Clock::now();
+            try {
+                uint64_t contentHash = resultCache ? ResultCache::hashFile(file.path) : 0;
+                bool toSolve = false;
+                unsigned int parserThreads = 1;
+                bool splitWhileParsing = true;
+                for (size_t indexTask : file.sameFile) {
+                    const Method &method = methods[tasks[indexTask].method];
+                    parserThreads = std::max(parserThreads, method.parserThreads);
+                    splitWhileParsing = splitWhileParsing && isSplitWhileReading(method);
+                    auto &cachedResult = file.cachedResults.emplace_back();
+                    std::string &key = file.keys.emplace_back();
+                    if (resultCache) {
+                        key = ResultCache::getKey(contentHash, method.engine, method.useRevisited, method.prefixSort);
+                        std::lock_guard lock(resultCacheMutex);
+                        const ResultCache::Result *found = forceSolve ? nullptr : resultCache->find(key);
+                        if (found != nullptr) cachedResult = *found;
+                    }
+                    toSolve = toSolve || !cachedResult;
+                }
+                if (toSolve) {
+                    if (memoryLimit != 0) checkMemoryLimit(file.path, file.sameFile);
+                    busyRead += Clock::now() - start;
+                    if (!freeInstances.pop(file.instance)) return;
+                    start = Clock::now();
+                    if (verbose >= 2) std::cout << "Parsing instance : " << file.path << std::endl;
+                    const Instance *cachedInstance;
+                    {
+                        MemoryTracker::Scope memoryScope(file.parseMemory);
+                        cachedInstance = &instanceCache.get(file.path, parser, parserThreads, splitWhileParsing);
+                    }
+                    MemoryTracker::Scope memoryScope(file.copyMemory);
+                    *file.instance = *cachedInstance;
+                }
+            } catch (...) {
+                file.error = std::current_exception();
+            }
+            busyRead += Clock::now() - start;
+            bool stop = file.error != nullptr;
+            if (!readQueue.push(std::move(file)) || stop) break;
+        }
+        readQueue.close();
+    });
+
+    std::exception_ptr writeError;
+    std::thread writer([&]() {
+        TRACE_SCOPE("SolvePlan::runPipeline::write");
+        std::map<std::string, std::ofstream> outputFiles;
+        RowItem item;
+        try {
+            while (writeQueue.pop(item)) {
+                auto start = Clock::now();
+                auto it = outputFiles.find(item.outputPath);
+                if (it == outputFiles.end()) {
+                    bool fileExists = std::filesystem::exists(item.outputPath);
+                    std::filesystem::create_directories(std::filesystem::path(item.outputPath).lexically_normal().parent_path());
+                    it = outputFiles.emplace(item.outputPath, std::ofstream(item.outputPath, std::ios::out | std::ios::app | std::ios::ate)).first;
+                    if (!it->second.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(item.outputPath).c_str());
+                    if (!fileExists) Solver::printHeader(it->second, item.useRevisited);
+                }
+                it->second << item.row;
+                busyWrite += Clock::now() - start;
+            }
+        } catch (...) {
+            writeError = std::current_exception();
+            writeQueue.close();
+        }
+    });
+
+    // the solver stage runs in the calling thread
+    FileItem file;
+    try {
+        while (readQueue.pop(file)) {
+            auto start = Clock::now();
+            if (file.error) std::rethrow_exception(file.error);
+            // the methods are solved on a copy of the instance, except the last one which solves the instance itself
+            size_t lastToSolve = file.sameFile.size();
+            for (size_t indexFile = 0; indexFile < file.sameFile.size(); ++indexFile)
+                if (!file.cachedResults[indexFile]) lastToSolve = indexFile;
+            for (size_t indexFile = 0; indexFile < file.sameFile.size(); ++indexFile) {
+                Task &task = tasks[file.sameFile[indexFile]];
+                const Method &method = methods[task.method];
+                std::ostringstream rowStream;
+                if (file.cachedResults[indexFile]) {
+                    if (verbose >= 2) std::cout << "Cached result of instance : " << task.path << std::endl;
+                    if (writeRows) ResultCache::printRow(*file.cachedResults[indexFile], task.path, method.useRevisited, rowStream);
+                    if (summary) addToSummary(task.method, *file.cachedResults[indexFile], CACHED_TIMES);
+                } else {
+                    MemoryTracker::resetPeakRSS();
+                    // each method counts the copy of its instance, as without a pipeline: the copy in the ring for
+                    // the last one, the copy in the work instance for the others
+                    MemoryUsage parseMemory = file.parseMemory;
+                    file.parseMemory = MemoryUsage();
+                    Instance *instance = file.instance;
+                    if (indexFile != lastToSolve) {
+                        MemoryTracker::Scope memoryScope(parseMemory);
+                        *workInstance = *file.instance;
+                        instance = workInstance.get();
+                    } else {
+                        parseMemory.allocatedBytes += file.copyMemory.allocatedBytes;
+                        parseMemory.nbAllocations += file.copyMemory.nbAllocations;
+                        parseMemory.peakBytes = std::max(parseMemory.peakBytes, file.copyMemory.peakBytes);
+                    }
+                    auto result = runInMemory(task.method, *instance, parseMemory, &rowStream);
+                    if (resultCache) {
+                        std::lock_guard lock(resultCacheMutex);
+                        resultCache->insert(file.keys[indexFile], result);
+                    }
+                }
+                busySolve += Clock::now() - start;
+                if (writeRows && !writeQueue.push({method.outputPath, method.useRevisited, rowStream.str()})) std::rethrow_exception(writeError);
+                start = Clock::now();
+            }
+            if (file.instance != nullptr) freeInstances.push(file.instance);
+            busySolve += Clock::now() - start;
+        }
+    } catch (...) {
+        readQueue.close();
+        freeInstances.close();
+        writeQueue.close();
+        reader.join();
+        writer.join();
+        throw;
+    }
+    writeQueue.close();
+    reader.join();
+    writer.join();
+    if (writeError) std::rethrow_exception(writeError);
+
+    // utilisation of each stage over the run of the pipeline
+    double total = std::chrono::duration<double>(Clock::now() - startPipeline).count();
+    auto report = [total](const char *stage, Clock::duration busy) {
+        double seconds = std::chrono::duration<double>(busy).count();
+        std::cout << "    " << std::left << std::setw(8) << stage << std::right << std::fixed << std::setprecision(6) << seconds
+                  << " s busy, " << std::setprecision(1) << (total > 0.0 ? 100.0 * seconds / total : 0.0) << " %" << std::endl;
+    };
+    std::ios_base::fmtflags flags = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    std::cout << "Pipeline of " << files.size() << " instance files with depth " << pipelineDepth << " in "
+              << std::fixed << std::setprecision(6) << total << " s" << std::endl;
+    report("read", busyRead);
+    report("solve", busySolve);
+    report("write", busyWrite);
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
+
+void SolvePlan::run(const Parser &parser, InstanceCache &instanceCache, InstancePool &instancePool) {
+    TRACE_SCOPE("SolvePlan::run");
+    std::unique_ptr<ResultCache> resultCache;
+    if (!resultCachePath.empty()) resultCache = std::make_unique<ResultCache>(resultCachePath);
+    std::vector<bool> done(tasks.size(), false);
+    if (pipelineDepth > 0) runPipeline(parser, instanceCache, resultCache.get(), instancePool, done);
+    for (size_t indexTask = 0; indexTask < tasks.size(); ++indexTask) {
+        if (done[indexTask]) continue;
+        Task &task = tasks[indexTask];
+        const Method &method = methods[task.method];
+        if (task.fileDescriptor >= 0) {
+            if (verbose >= 2) std::cout << "Parsing instance from file descriptor : " << task.fileDescriptor << std::endl;
+            MemoryTracker::resetPeakRSS();
+            MemoryUsage parseMemory;
+            auto newInstance = instancePool.acquire();
+            {
+                MemoryTracker::Scope memoryScope(parseMemory);
+                // the jobs are split while they are read, unless the engine needs them in the order of the input
+                parser.readFromFileDescriptor(task.fileDescriptor, *newInstance, isSplitWhileReading(method));
+            }
+            runInMemory(task.method, *newInstance, parseMemory);
+            continue;
+        }
+        if (method.useOutOfCore) {
+            runOutOfCore(method, task.path);
+            continue;
+        }
+        if (method.useFlowShop) {
+            runFlowShop(method, task.path, parser);
+            continue;
+        }
+
+        // the next tasks of the same file are run now, the file is parsed with the most threads asked by their methods, and
+        // split by these threads if no method needs the jobs in the order of the file
+        unsigned int parserThreads;
+        bool splitWhileParsing;
+        std::vector<size_t> sameFile = findSameFile(indexTask, done, parserThreads, splitWhileParsing);
+        uint64_t contentHash = resultCache ? ResultCache::hashFile(task.path) : 0;
+        const Instance *cachedInstance = nullptr; // parsed only if a method has no cached result
+        for (size_t indexOther : sameFile) {
+            done[indexOther] = true;
+            const Method &otherMethod = methods[tasks[indexOther].method];
+            std::string key;
+            if (resultCache) {
+                key = ResultCache::getKey(contentHash, otherMethod.engine, otherMethod.useRevisited, otherMethod.prefixSort);
+                const ResultCache::Result *cachedResult = forceSolve ? nullptr : resultCache->find(key);
+                if (cachedResult != nullptr) {
+                    if (verbose >= 2) std::cout << "Cached result of instance : " << tasks[indexOther].path << std::endl;
+                    if (writeRows) ResultCache::printOutput(*cachedResult, tasks[indexOther].path, otherMethod.useRevisited, otherMethod.outputPath);
+                    if (summary) addToSummary(tasks[indexOther].method, *cachedResult, CACHED_TIMES);
+                    continue;
+                }
+            }
+            MemoryTracker::resetPeakRSS();
+            MemoryUsage parseMemory;
+            if (cachedInstance == nullptr) {
+                if (memoryLimit != 0) checkMemoryLimit(task.path, sameFile);
+                if (verbose >= 2) std::cout << "Parsing instance : " << task.path << std::endl;
+                MemoryTracker::Scope memoryScope(parseMemory);
+                cachedInstance = &instanceCache.get(task.path, parser, parserThreads, splitWhileParsing);
+            }
+            auto newInstance = instancePool.acquire();
+            {
+                MemoryTracker::Scope memoryScope(parseMemory);
+                // the solvers move the jobs, they work on a copy of the cached instance
+                *newInstance = *cachedInstance;
+            }
+            auto result = runInMemory(tasks[indexOther].method, *newInstance, parseMemory);
+            if (resultCache) resultCache->insert(key, result);
+        }
+    }
+    if (resultCache) resultCache->save();
+    if (summary) summary->printOutput(summaryPath);
+}
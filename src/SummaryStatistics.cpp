@@ -0,0 +1,178 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+
+#include "SummaryStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include "F2CmaxException.h"
+
+void QuantileSketch::add(double value) {
+    if (count < heights.size()) {
+        heights[count++] = value;
+        if (count == heights.size()) {
+            std::sort(heights.begin(), heights.end());
+            positions = {1.0, 2.0, 3.0, 4.0, 5.0};
+            desiredPositions = {1.0, 1.0 + 2.0 * quantile, 1.0 + 4.0 * quantile, 3.0 + 2.0 * quantile, 5.0};
+            increments = {0.0, quantile / 2.0, quantile, (1.0 + quantile) / 2.0, 1.0};
+        }
+        return;
+    }
+    ++count;
+    // cell of the value between the markers, the extreme markers take a new minimum or maximum
+    size_t cell;
+    if (value < heights[0]) {
+        heights[0] = value;
+        cell = 0;
+    } else if (value >= heights[4]) {
+        heights[4] = value;
+        cell = 3;
+    } else {
+        cell = 0;
+        while (value >= heights[cell + 1]) ++cell;
+    }
+    for (size_t marker = cell + 1; marker < positions.size(); ++marker) positions[marker] += 1.0;
+    for (size_t marker = 0; marker < positions.size(); ++marker) desiredPositions[marker] += increments[marker];
+
+    // move the middle markers which are at least one position away from their desired position
+    for (size_t marker = 1; marker < 4; ++marker) {
+        double shift = desiredPositions[marker] - positions[marker];
+        if ((shift >= 1.0 && positions[marker + 1] - positions[marker] > 1.0) || (shift <= -1.0 && positions[marker - 1] - positions[marker] < -1.0)) {
+            double sign = shift >= 0.0 ? 1.0 : -1.0;
+            double height = heights[marker] + sign / (positions[marker + 1] - positions[marker - 1])
+                * ((positions[marker] - positions[marker - 1] + sign) * (heights[marker + 1] - heights[marker]) / (positions[marker + 1] - positions[marker])
+                   + (positions[marker + 1] - positions[marker] - sign) * (heights[marker] - heights[marker - 1]) / (positions[marker] - positions[marker - 1]));
+            if (heights[marker - 1] < height && height < heights[marker + 1]) heights[marker] = height;
+            else {
+                // the parabolic prediction is not monotonic, the linear one is used
+                size_t neighbour = sign > 0.0 ? marker + 1 : marker - 1;
+                heights[marker] += sign * (heights[neighbour] - heights[marker]) / (positions[neighbour] - positions[marker]);
+            }
+            positions[marker] += sign;
+        }
+    }
+}
+
+double QuantileSketch::getValue() const {
+    if (count == 0) return 0.0;
+    if (count > heights.size()) return heights[2];
+    // exact quantile of the first values, sorted by insertion as they are at most 5
+    std::array<double,5> sorted = heights;
+    for (size_t index = 1; index < count; ++index)
+        for (size_t previous = index; previous > 0 && sorted[previous] < sorted[previous - 1]; --previous)
+            std::swap(sorted[previous], sorted[previous - 1]);
+    return sorted[static_cast<size_t>(std::lround(quantile * static_cast<double>(count - 1)))];
+}
+
+RunningStatistics::RunningStatistics(std::span<const double> quantiles) {
+    sketches.reserve(quantiles.size());
+    for (double quantile : quantiles) sketches.emplace_back(quantile);
+}
+
+void RunningStatistics::add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    sumSquares += delta * (value - mean);
+    min = count == 1 ? value : std::min(min, value);
+    max = count == 1 ? value : std::max(max, value);
+    for (auto &sketch : sketches) sketch.add(value);
+}
+
+double RunningStatistics::getStdDev() const {
+    return count < 2 ? 0.0 : std::sqrt(sumSquares / static_cast<double>(count - 1));
+}
+
+SummaryStatistics::SummaryStatistics(std::vector<double> quantiles) : quantiles(std::move(quantiles)) {
+    for (double quantile : this->quantiles)
+        if (!(quantile >= 0.0 && quantile <= 1.0)) throw std::invalid_argument(R"(The "quantiles" must be numbers between 0 and 1)");
+}
+
+std::string SummaryStatistics::getDistribution(const std::string &instanceName) {
+    const std::string prefix = "_distribution_";
+    auto pos = instanceName.find(prefix);
+    if (pos == std::string::npos) return "unknown";
+    std::string distribution = instanceName.substr(pos + prefix.size());
+    return distribution.substr(0, distribution.find('_'));
+}
+
+void SummaryStatistics::add(const Group &group, const std::array<double, NB_COLUMNS> &values) {
+    auto it = groups.find(group);
+    if (it == groups.end()) it = groups.emplace(group, std::vector<RunningStatistics>(NB_COLUMNS, RunningStatistics(quantiles))).first;
+    for (size_t column = 0; column < NB_COLUMNS; ++column) {
+        bool isTime = column < Solver::NB_TIMES;
+        if (std::isnan(values[column]) || (isTime && values[column] == 0.0)) continue;
+        it->second[column].add(values[column]);
+    }
+}
+
+void SummaryStatistics::write(std::ostream &outputStream, bool withHeader) const {
+    if (withHeader) {
+        outputStream << "Method" << "\t" << "Engine" << "\t" << "Distribution" << "\t" << "pmax" << "\t" << "n" << "\t" << "Column"
+                     << "\t" << "Count" << "\t" << "Mean" << "\t" << "StdDev" << "\t" << "Min";
+        for (double quantile : quantiles) outputStream << "\t" << "P" << quantile * 100.0;
+        outputStream << "\t" << "Max" << std::endl;
+    }
+    // the values are written with all their digits, so that the summaries of shards are merged without loss
+    std::streamsize precision = outputStream.precision(std::numeric_limits<double>::max_digits10);
+    for (auto &[group, statistics] : groups) {
+        auto &[method, distribution, pmax, n] = group;
+        for (size_t column = 0; column < NB_COLUMNS; ++column) {
+            const RunningStatistics &columnStatistics = statistics[column];
+            if (columnStatistics.getCount() == 0) continue;
+            outputStream << method
+                         << "\t" << (method < engineNames.size() ? engineNames[method] : "")
+                         << "\t" << distribution
+                         << "\t" << pmax
+                         << "\t" << n
+                         << "\t" << (column < Solver::NB_TIMES ? Solver::TIME_COLUMNS[column] : column == Solver::NB_TIMES ? "K_a" : "K_b")
+                         << "\t" << columnStatistics.getCount()
+                         << "\t" << columnStatistics.getMean()
+                         << "\t" << columnStatistics.getStdDev()
+                         << "\t" << columnStatistics.getMin();
+            for (auto &sketch : columnStatistics.getSketches()) outputStream << "\t" << sketch.getValue();
+            outputStream << "\t" << columnStatistics.getMax() << std::endl;
+        }
+    }
+    outputStream.precision(precision);
+}
+
+void SummaryStatistics::printOutput(const std::string &fileOutputName) const {
+    bool fileExists = std::filesystem::exists(fileOutputName);
+    auto filePath = std::filesystem::path(fileOutputName);
+    if (filePath.has_parent_path()) std::filesystem::create_directories(filePath.lexically_normal().parent_path());
+    std::ofstream outputFile(fileOutputName, std::ios::out | std::ios::app | std::ios::ate);
+    if (!outputFile.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(fileOutputName).c_str());
+    write(outputFile, !fileExists);
+}
+
+void SummaryStatistics::setEngineName(size_t method, const std::string &engineName) {
+    if (engineNames.size() <= method) engineNames.resize(method + 1);
+    engineNames[method] = engineName;
+}
@@ -0,0 +1,119 @@
+// Copyright (C) 2026
+// Laboratoire d'Informatique Fondamentale et Appliquée de Tours, Tours, France
+//
+// DIGEP, Politecnico di Torino, Corso Duca degli Abruzzi 24, Torino, Italy
+// This file is part of F2-Cmax-revisited.
+//
+// F2-Cmax-revisited is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// F2-Cmax-revisited is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with F2-Cmax-revisited. If not, see <https://www.gnu.org/licenses/>.
+
+//
+// Created by schau on 10/18/26.
+//
+
+#include "Trace.h"
+
+#ifdef F2_CMAX_TRACE
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "F2CmaxException.h"
+
+namespace {
+    struct Event {
+        const char *name;
+        int64_t start; // in nanoseconds
+        int64_t duration;
+    };
+
+    // The events of one thread, the ring grows up to BUFFER_CAPACITY events as they are recorded. At the end of the
+    // thread, the buffer is kept by the registry with its events and reused by the next new thread, so the threads
+    // created for each call do not add a buffer each
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        size_t nbRecorded = 0; // the event i is at events[i % BUFFER_CAPACITY]
+        size_t threadIndex = 0;
+    };
+
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+    std::vector<ThreadBuffer *> freeBuffers; // buffers of the threads which have ended
+
+    // The buffer of the calling thread, given back to the registry at the end of the thread
+    struct ThreadSlot {
+        ThreadBuffer *threadBuffer = nullptr;
+
+        ~ThreadSlot() {
+            if (threadBuffer == nullptr) return;
+            std::lock_guard lock(registryMutex);
+            freeBuffers.push_back(threadBuffer);
+        }
+    };
+
+    ThreadBuffer &getThreadBuffer() {
+        thread_local ThreadSlot threadSlot;
+        if (threadSlot.threadBuffer == nullptr) {
+            std::lock_guard lock(registryMutex);
+            if (!freeBuffers.empty()) {
+                threadSlot.threadBuffer = freeBuffers.back();
+                freeBuffers.pop_back();
+            } else {
+                threadSlot.threadBuffer = registry.emplace_back(std::make_unique<ThreadBuffer>()).get();
+                threadSlot.threadBuffer->threadIndex = registry.size() - 1;
+            }
+        }
+        return *threadSlot.threadBuffer;
+    }
+}
+
+std::atomic<bool> Trace::enabled{false};
+const std::chrono::steady_clock::time_point Trace::origin = std::chrono::steady_clock::now();
+
+void Trace::record(const char *name, int64_t start, int64_t end) {
+    ThreadBuffer &threadBuffer = getThreadBuffer();
+    if (threadBuffer.nbRecorded < BUFFER_CAPACITY) threadBuffer.events.push_back({name, start, end - start});
+    else threadBuffer.events[threadBuffer.nbRecorded % BUFFER_CAPACITY] = {name, start, end - start};
+    ++threadBuffer.nbRecorded;
+}
+
+void Trace::write(const std::string &tracePath) {
+    auto path = std::filesystem::path(tracePath);
+    if (path.has_parent_path()) std::filesystem::create_directories(path.lexically_normal().parent_path());
+    std::ofstream traceFile(tracePath);
+    if (!traceFile.is_open()) throw F2CmaxException(std::string("Can't open the file ").append(tracePath).c_str());
+    traceFile << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::lock_guard lock(registryMutex);
+    for (auto &threadBuffer : registry) {
+        traceFile << (first ? "" : ",") << "\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << threadBuffer->threadIndex
+                  << ",\"name\":\"thread_name\",\"args\":{\"name\":\"thread " << threadBuffer->threadIndex << "\"}}";
+        first = false;
+        size_t nbEvents = std::min(threadBuffer->nbRecorded, BUFFER_CAPACITY);
+        for (size_t indexEvent = threadBuffer->nbRecorded - nbEvents; indexEvent < threadBuffer->nbRecorded; ++indexEvent) {
+            const Event &event = threadBuffer->events[indexEvent % BUFFER_CAPACITY];
+            // the times of the Chrome trace format are in microseconds
+            traceFile << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << threadBuffer->threadIndex << ",\"name\":\"" << event.name
+                      << "\",\"ts\":" << static_cast<double>(event.start) / 1000.0
+                      << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << "}";
+        }
+    }
+    traceFile << "\n]}" << std::endl;
+    traceFile.close();
+}
+
+#endif
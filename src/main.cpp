@@ -26,25 +26,87 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 
-#include "Solver.h"
+#include "CostModel.h"
+#include "InstanceCache.h"
+#include "InstancePool.h"
+#include "JobAllocator.h"
+#include "ScalingSweep.h"
+#include "Server.h"
+#include "Shard.h"
+#include "SolvePlan.h"
+#include "Trace.h"
 
 
 int main(int argc, char **argv) {
 
-    if (argc < 2) {
+    // the option "--shard i/N" (or "--shard=i/N") solves only the shard i of N of the instances, the other arguments are configs
+    Shard shard;
+    std::vector<std::string> configPaths;
+    try {
+        for (int indexArg = 1; indexArg < argc; ++indexArg) {
+            std::string arg = argv[indexArg];
+            if (arg == "--shard") {
+                if (++indexArg == argc) throw std::invalid_argument("The option --shard needs a shard i/N");
+                shard = Shard::parse(argv[indexArg]);
+            } else if (arg.starts_with("--shard=")) shard = Shard::parse(arg.substr(8));
+            else configPaths.push_back(arg);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+    if (configPaths.empty()) {
         std::cerr << "ERROR: You need at least one argument." << std::endl;
         return -1;
     }
-    char **pargv = argv + 1;
+    auto pargv = configPaths.begin();
+    // instances parsed once for all the configs, and instances reused from one file to the next
+    InstanceCache instanceCache;
+    InstancePool instancePool;
     try {
-        for (; *pargv != argv[argc]; pargv++) {
-            auto pathFile = std::filesystem::path(std::string(*pargv));
+        for (; pargv != configPaths.end(); pargv++) {
+            auto pathFile = std::filesystem::path(*pargv);
             if (! std::filesystem::exists(pathFile)) {
                 throw F2CmaxException(std::string("The file configuration use do not exist. Path: ").append(pathFile.string()));
             }
             std::ifstream f(*pargv);
             // parse json input config file
-            nlohmann::json config = nlohmann::json::parse(f);
+            nlohmann::json config;
+            {
+                TRACE_SCOPE("main::parseConfig");
+                config = nlohmann::json::parse(f);
+            }
+
+            // record the phases of the run in a Chrome trace file
+            std::string tracePath;
+            if (config.contains("trace")) {
+                if (config["trace"].is_string()) tracePath = config["trace"].get<std::string>();
+                else throw std::invalid_argument(R"(The "trace" must be a string)");
+                if (Trace::COMPILED) Trace::enable();
+                else std::cerr << R"(The "trace" is ignored, the tracing is not compiled (cmake -DF2_CMAX_TRACE=ON))" << std::endl;
+            }
+
+            // allocation policy of the large job arrays, kept for the next configs
+            if (config.contains("allocation")) {
+                auto &allocation = config["allocation"];
+                if (!allocation.is_object()) throw std::invalid_argument(R"(The "allocation" must be an object)");
+                if (allocation.contains("hugePages")) {
+                    if (allocation["hugePages"] == "none") AllocationPolicy::setHugePages(NO_HUGE_PAGES);
+                    else if (allocation["hugePages"] == "transparent") AllocationPolicy::setHugePages(TRANSPARENT_HUGE_PAGES);
+                    else if (allocation["hugePages"] == "explicit") AllocationPolicy::setHugePages(EXPLICIT_HUGE_PAGES);
+                    else throw std::invalid_argument(R"(The "hugePages" must be "none", "transparent" or "explicit" in the "allocation" object)");
+                }
+                if (allocation.contains("numa")) {
+                    if (allocation["numa"] == "none") AllocationPolicy::setNuma(NO_NUMA);
+                    else if (allocation["numa"] == "interleave") AllocationPolicy::setNuma(NUMA_INTERLEAVE);
+                    else if (allocation["numa"] == "firstTouch") AllocationPolicy::setNuma(NUMA_FIRST_TOUCH);
+                    else throw std::invalid_argument(R"(The "numa" must be "none", "interleave" or "firstTouch" in the "allocation" object)");
+                }
+                if (allocation.contains("threads")) {
+                    if (allocation["threads"].is_number_unsigned() && allocation["threads"] > 0) AllocationPolicy::setNbTouchThreads(allocation["threads"].get<unsigned int>());
+                    else throw std::invalid_argument(R"(The "threads" must be a positive integer in the "allocation" object)");
+                }
+            }
 
             // create instance parser
             Parser parser = Parser();
@@ -54,61 +116,83 @@ int main(int argc, char **argv) {
             /********************************/
 
             if (config.contains("generate")) {
+                TRACE_SCOPE("main::generate");
                 // generate them with Parser
                 parser.generateInstance(config["generate"]);
             }
 
+            /*******************************/
+            /*      CALIBRATE ENGINES      */
+            /*******************************/
+
+            if (config.contains("calibrate")) {
+                TRACE_SCOPE("main::calibrate");
+                if (!config["calibrate"].contains("output") || !config["calibrate"]["output"].is_string())
+                    throw std::invalid_argument(R"(The "calibrate" object must have an "output" string)");
+                CostModel costModel;
+                costModel.calibrate(config["calibrate"]);
+                costModel.saveToFile(config["calibrate"]["output"].get<std::string>());
+            }
+
+            /*****************************/
+            /*      SWEEP THE SCALING      */
+            /*****************************/
+
+            if (config.contains("sweep")) {
+                TRACE_SCOPE("main::sweep");
+                ScalingSweep scalingSweep(config["sweep"]);
+                scalingSweep.run();
+            }
+
             /*****************************/
             /*      SOLVE INSTANCES      */
             /*****************************/
 
             if (config.contains("solve")) {
-                // set verbose mode
-                char verbose = config["solve"].contains("verbose") && config["solve"]["verbose"].is_number_unsigned()
-                               ? config["solve"]["verbose"].template get<char>() : 0;
-
-                if (config["solve"].contains("methods")) {
-                    // for each method
-                    for (auto &method: config["solve"]["methods"]) {
-                        // set output path
-                        std::string outputPath;
-                        if (config["solve"].contains("output") && config["solve"]["output"].is_string())
-                            outputPath = std::filesystem::path(config["solve"]["output"].template get<std::string>());
-                        else {
-                            outputPath = std::filesystem::current_path().parent_path().parent_path().string() +
-                                         "/instances/";
-                        }
-
-                        // keep the path without the extension and add the name method;
-                        outputPath.append("resultsF2Cmax.csv");
-                        if (verbose >= 2) std::cout << "Save results in the path : " << outputPath << std::endl;
-                        std::ofstream outputFileStream;
-
-                        if (method.contains("instances")) {
-                            // loop over each instances
-                            for (auto &instance: method["instances"]) {
-                                Instance newInstance;
-                                if (instance.contains("path")) {
-                                    if (instance["path"].is_string()) {
-                                        std::string path = instance["path"];
-                                        if (verbose >= 2) std::cout << "Parsing instance : " << path << std::endl;
-                                        newInstance = parser.readFromFile(path);
-                                        bool useRevisited = true;
-                                        if (method.contains("useRevisited")) {
-                                            if (method["useRevisited"].is_boolean()) useRevisited = method["useRevisited"].get<bool>();
-                                            else throw std::invalid_argument(R"(The "useRevisited" must be an boolean)");
-                                        }
-                                        Solver solver(&newInstance,useRevisited);
-                                        solver.solve();
-                                        solver.printOutput(outputPath, outputFileStream);
-                                    } else throw std::invalid_argument(R"(The instance path is not a string)");
-                                } else throw std::invalid_argument(R"(The instance don't have attribute "path")");
-                            }
-                        }
-                        outputFileStream.close();
-                    }
-                } else throw std::invalid_argument(R"(The config don't have attribute "methods")");
+                TRACE_SCOPE("main::solve");
+                if (config["solve"].contains("instanceCache")) {
+                    if (config["solve"]["instanceCache"].is_number_unsigned()) instanceCache.setCapacity(config["solve"]["instanceCache"].get<size_t>());
+                    else throw std::invalid_argument(R"(The "instanceCache" must be an unsigned integer)");
+                }
+                SolvePlan solvePlan(config["solve"], shard);
+                solvePlan.run(parser, instanceCache, instancePool);
+            }
+
+            /***************************/
+            /*      MERGE SHARDS       */
+            /***************************/
+
+            if (config.contains("merge")) {
+                TRACE_SCOPE("main::merge");
+                auto &merge = config["merge"];
+                if (!merge.is_object()) throw std::invalid_argument(R"(The "merge" must be an object)");
+                if (!merge.contains("output") || !merge["output"].is_string())
+                    throw std::invalid_argument(R"(The "merge" object must have an "output" string)");
+                if (!merge.contains("shards") || !merge["shards"].is_number_unsigned())
+                    throw std::invalid_argument(R"(The "merge" object must have a "shards" unsigned integer)");
+                Shard::merge(merge["output"].get<std::string>(), merge["shards"].get<unsigned int>());
+            }
+
+            /*************************/
+            /*      SERVER MODE      */
+            /*************************/
+
+            if (config.contains("serve")) {
+                auto &serve = config["serve"];
+                if (!serve.is_object()) throw std::invalid_argument(R"(The "serve" must be an object)");
+                unsigned int nbThreads = 1;
+                if (serve.contains("threads")) {
+                    if (serve["threads"].is_number_unsigned()) nbThreads = serve["threads"].get<unsigned int>();
+                    else throw std::invalid_argument(R"(The "threads" must be an unsigned integer in the "serve" object)");
+                }
+                Server server(nbThreads);
+                if (serve.contains("socket")) {
+                    if (serve["socket"].is_string()) server.serveSocket(serve["socket"].get<std::string>());
+                    else throw std::invalid_argument(R"(The "socket" must be a string in the "serve" object)");
+                } else server.serveStream(std::cin, std::cout);
             }
+
+            if (!tracePath.empty() && Trace::COMPILED) Trace::write(tracePath);
         }
     }catch (const std::exception &e) {
         std::cerr << "Error with "<< *pargv << std::endl << "Error: " << e.what();